@@ -7,6 +7,7 @@
 #include <functional>
 #include <cmath>
 #include <algorithm>
+#include <type_traits>
 
 namespace sjtu
 {
@@ -179,7 +180,7 @@ namespace sjtu
 	template<class VecIter>
 	void sort(VecIter beg, VecIter end)
 	{
-		sjtu::sort(beg, end, std::less<>());
+		sjtu::sort(beg, end, std::less<typename std::decay<decltype(*beg)>::type>());
 	}
 }
 
@@ -0,0 +1,723 @@
+#ifndef SJTU_CONCURRENT_QUEUE_HPP
+#define SJTU_CONCURRENT_QUEUE_HPP
+
+#include "queue.hpp"
+#include "priority_queue.hpp"
+#include "exceptions.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstdint>
+#include <new>
+#include <atomic>
+#include <utility>
+#include <type_traits>
+#include <thread>
+#include <mutex>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+
+namespace sjtu
+{
+	//size of a cache line, the indices written by different threads are kept this far apart
+	//so that the producer and the consumer don't invalidate each other's cache line (false sharing)
+	static const size_t cache_line_size = 64;
+
+	//an atomic index occupying a whole cache line
+	struct alignas(64) padded_index
+	{
+		std::atomic<size_t> value;
+		char pad[cache_line_size - sizeof(std::atomic<size_t>)];
+
+		padded_index() : value(0) {}
+	};
+
+	//round n up to a power of two, at least 2
+	inline size_t _ceil_pow2(size_t n)
+	{
+		size_t ans = 2;
+		while (ans < n)
+			ans *= 2;
+		return ans;
+	}
+
+	//a bounded lock-free queue for exactly one producer thread and one consumer thread.
+	//The producer only writes tail and the consumer only writes head, and each of them keeps
+	//a private copy of the other index, which is reloaded only when the queue looks full or empty.
+	template<typename T>
+	class spsc_queue
+	{
+	private:
+		T *start;
+		size_t mask;//capacity - 1
+
+		padded_index head;//next slot to pop, written by the consumer
+		padded_index tail;//next slot to push, written by the producer
+
+		struct alignas(64) cached_index
+		{
+			size_t value;
+			char pad[cache_line_size - sizeof(size_t)];
+
+			cached_index() : value(0) {}
+		};
+		cached_index headCache;//the producer's copy of head
+		cached_index tailCache;//the consumer's copy of tail
+
+		//number of free slots seen by the producer, t is the producer's own index.
+		//head is reloaded only when the cached one shows less than want slots
+		size_t freeSlots(size_t t, size_t want)
+		{
+			size_t room = mask + 1 - (t - headCache.value);
+			if (room < want)
+			{
+				headCache.value = head.value.load(std::memory_order_acquire);
+				room = mask + 1 - (t - headCache.value);
+			}
+			return room;
+		}
+
+		//number of elements seen by the consumer, h is the consumer's own index
+		size_t readySlots(size_t h, size_t want)
+		{
+			size_t cnt = tailCache.value - h;
+			if (cnt < want)
+			{
+				tailCache.value = tail.value.load(std::memory_order_acquire);
+				cnt = tailCache.value - h;
+			}
+			return cnt;
+		}
+
+	public:
+		//the capacity is rounded up to a power of two
+		explicit spsc_queue(size_t capacity) :
+			mask(_ceil_pow2(capacity) - 1)
+		{
+			start = (T *)std::malloc((mask + 1) * sizeof(T));
+		}
+
+		spsc_queue(const spsc_queue &) = delete;
+		spsc_queue& operator=(const spsc_queue &) = delete;
+
+		//should not be called when other threads are still using the queue
+		~spsc_queue()
+		{
+			const size_t t = tail.value.load(std::memory_order_relaxed);
+			for (size_t h = head.value.load(std::memory_order_relaxed); h != t; h++)
+				(start + (h & mask))->~T();
+
+			std::free(start);
+		}
+
+		//producer only. return false if the queue is full
+		bool try_push(const T &value)
+		{
+			const size_t t = tail.value.load(std::memory_order_relaxed);
+			if (freeSlots(t, 1) == 0)
+				return false;
+
+			new (start + (t & mask)) T(value);
+			tail.value.store(t + 1, std::memory_order_release);
+			return true;
+		}
+
+		bool try_push(T &&value)
+		{
+			const size_t t = tail.value.load(std::memory_order_relaxed);
+			if (freeSlots(t, 1) == 0)
+				return false;
+
+			new (start + (t & mask)) T(std::move(value));
+			tail.value.store(t + 1, std::memory_order_release);
+			return true;
+		}
+
+		//producer only. push the first elements of the n ones from first as long as there is room,
+		//and publish them at once. return the number of pushed elements
+		template<typename InputIt>
+		size_t try_push_bulk(InputIt first, size_t n)
+		{
+			const size_t t = tail.value.load(std::memory_order_relaxed);
+			size_t cnt = freeSlots(t, n);
+			if (cnt > n)
+				cnt = n;
+
+			for (size_t i = 0; i < cnt; i++, ++first)
+				new (start + ((t + i) & mask)) T(*first);
+
+			if (cnt > 0)
+				tail.value.store(t + cnt, std::memory_order_release);
+			return cnt;
+		}
+
+		//consumer only. return false if the queue is empty
+		bool try_pop(T &out)
+		{
+			const size_t h = head.value.load(std::memory_order_relaxed);
+			if (readySlots(h, 1) == 0)
+				return false;
+
+			T *p = start + (h & mask);
+			out = std::move(*p);
+			p->~T();
+			head.value.store(h + 1, std::memory_order_release);
+			return true;
+		}
+
+		//consumer only. pop at most max elements into out and release the slots at once.
+		//return the number of popped elements
+		template<typename OutputIt>
+		size_t try_pop_bulk(OutputIt out, size_t max)
+		{
+			const size_t h = head.value.load(std::memory_order_relaxed);
+			size_t cnt = readySlots(h, max);
+			if (cnt > max)
+				cnt = max;
+
+			for (size_t i = 0; i < cnt; i++, ++out)
+			{
+				T *p = start + ((h + i) & mask);
+				*out = std::move(*p);
+				p->~T();
+			}
+
+			if (cnt > 0)
+				head.value.store(h + cnt, std::memory_order_release);
+			return cnt;
+		}
+
+		//only a snapshot when other threads are working on the queue
+		size_t size_approx() const
+		{
+			const size_t h = head.value.load(std::memory_order_acquire);
+			return tail.value.load(std::memory_order_acquire) - h;
+		}
+
+		bool empty() const
+		{
+			return size_approx() == 0;
+		}
+
+		size_t capacity() const
+		{
+			return mask + 1;
+		}
+	};
+
+	//a bounded lock-free queue for any number of producers and consumers.
+	//Each slot carries a sequence number telling whether it's ready for the producer of a round
+	//or for the consumer of that round, so a thread claims a slot by a single CAS on the index
+	//and publishes it by storing the sequence, without touching the other index.
+	template<typename T>
+	class mpmc_queue
+	{
+	private:
+		struct cell
+		{
+			std::atomic<size_t> sequence;
+			typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+
+			T* data()
+			{
+				return reinterpret_cast<T *>(&storage);
+			}
+		};
+
+		cell *cells;
+		size_t mask;//capacity - 1
+
+		padded_index enqueuePos;
+		padded_index dequeuePos;
+
+		//claim at most n consecutive slots from pos on whose sequence is pos+i+offset,
+		//offset is 0 for producers and 1 for consumers.
+		//return the number of claimed slots and set pos to the first one, or 0 if there's none ready
+		size_t claim(padded_index &index, size_t &pos, size_t n, size_t offset)
+		{
+			pos = index.value.load(std::memory_order_relaxed);
+			for (;;)
+			{
+				size_t cnt = 0;
+				while (cnt < n)
+				{
+					const size_t seq = cells[(pos + cnt) & mask].sequence.load(std::memory_order_acquire);
+					const std::ptrdiff_t dif = (std::ptrdiff_t)seq - (std::ptrdiff_t)(pos + cnt + offset);
+					if (dif != 0)
+					{
+						if (cnt == 0 && dif > 0)
+							cnt = (size_t)-1;//another thread has claimed pos, reload it
+						break;
+					}
+					++cnt;
+				}
+
+				if (cnt == 0)
+					return 0;//full for producers or empty for consumers
+
+				if (cnt == (size_t)-1)
+					pos = index.value.load(std::memory_order_relaxed);
+				else if (index.value.compare_exchange_weak(pos, pos + cnt, std::memory_order_relaxed))
+					return cnt;
+			}
+		}
+
+	public:
+		//the capacity is rounded up to a power of two
+		explicit mpmc_queue(size_t capacity) :
+			mask(_ceil_pow2(capacity) - 1)
+		{
+			cells = (cell *)std::malloc((mask + 1) * sizeof(cell));
+			for (size_t i = 0; i <= mask; i++)
+				new (&cells[i].sequence) std::atomic<size_t>(i);
+		}
+
+		mpmc_queue(const mpmc_queue &) = delete;
+		mpmc_queue& operator=(const mpmc_queue &) = delete;
+
+		//should not be called when other threads are still using the queue
+		~mpmc_queue()
+		{
+			const size_t t = enqueuePos.value.load(std::memory_order_relaxed);
+			for (size_t h = dequeuePos.value.load(std::memory_order_relaxed); h != t; h++)
+				cells[h & mask].data()->~T();
+
+			std::free(cells);
+		}
+
+		//return false if the queue is full
+		bool try_push(const T &value)
+		{
+			size_t pos;
+			if (claim(enqueuePos, pos, 1, 0) == 0)
+				return false;
+
+			cell &c = cells[pos & mask];
+			new (c.data()) T(value);
+			c.sequence.store(pos + 1, std::memory_order_release);
+			return true;
+		}
+
+		bool try_push(T &&value)
+		{
+			size_t pos;
+			if (claim(enqueuePos, pos, 1, 0) == 0)
+				return false;
+
+			cell &c = cells[pos & mask];
+			new (c.data()) T(std::move(value));
+			c.sequence.store(pos + 1, std::memory_order_release);
+			return true;
+		}
+
+		//claim as many as n consecutive slots with one CAS and fill them with the elements from first.
+		//return the number of pushed elements
+		template<typename InputIt>
+		size_t try_push_bulk(InputIt first, size_t n)
+		{
+			size_t pos;
+			const size_t cnt = claim(enqueuePos, pos, n, 0);
+			for (size_t i = 0; i < cnt; i++, ++first)
+			{
+				cell &c = cells[(pos + i) & mask];
+				new (c.data()) T(*first);
+				c.sequence.store(pos + i + 1, std::memory_order_release);
+			}
+			return cnt;
+		}
+
+		//return false if the queue is empty
+		bool try_pop(T &out)
+		{
+			size_t pos;
+			if (claim(dequeuePos, pos, 1, 1) == 0)
+				return false;
+
+			cell &c = cells[pos & mask];
+			out = std::move(*c.data());
+			c.data()->~T();
+			c.sequence.store(pos + mask + 1, std::memory_order_release);
+			return true;
+		}
+
+		//claim at most max consecutive elements with one CAS and move them into out.
+		//return the number of popped elements
+		template<typename OutputIt>
+		size_t try_pop_bulk(OutputIt out, size_t max)
+		{
+			size_t pos;
+			const size_t cnt = claim(dequeuePos, pos, max, 1);
+			for (size_t i = 0; i < cnt; i++, ++out)
+			{
+				cell &c = cells[(pos + i) & mask];
+				*out = std::move(*c.data());
+				c.data()->~T();
+				c.sequence.store(pos + i + mask + 1, std::memory_order_release);
+			}
+			return cnt;
+		}
+
+		//only a snapshot when other threads are working on the queue
+		size_t size_approx() const
+		{
+			const size_t h = dequeuePos.value.load(std::memory_order_acquire);
+			const size_t t = enqueuePos.value.load(std::memory_order_acquire);
+			return t > h ? t - h : 0;
+		}
+
+		bool empty() const
+		{
+			return size_approx() == 0;
+		}
+
+		size_t capacity() const
+		{
+			return mask + 1;
+		}
+	};
+
+	//an unbounded queue on top of sjtu::queue for producer/consumer stages.
+	//A consumer finding it empty spins for a while watching the element count, which is read without the lock,
+	//and then sleeps on a condition variable. Producers only notify when somebody is asleep.
+	template<typename T, typename ListType = ring_buffer<T>>
+	class blocking_queue
+	{
+	private:
+		typedef std::chrono::steady_clock clock;
+
+		queue<T, ListType> q;
+		std::mutex m;
+		std::condition_variable notEmpty;
+		std::atomic<size_t> count;//size of q, written under the lock
+		std::atomic<bool> isClosed;
+		size_t sleepers;//number of consumers waiting on notEmpty, guarded by m
+		size_t spinLimit;
+
+		//spin until there seems to be an element, then take the lock and sleep if there's still none.
+		//return with the lock held, and whether there is an element to pop
+		bool waitForElement(std::unique_lock<std::mutex> &lock, const clock::time_point *deadline)
+		{
+			for (size_t i = 0; i < spinLimit; i++)
+			{
+				if (count.load(std::memory_order_relaxed) > 0 || isClosed.load(std::memory_order_relaxed))
+					break;
+				if (i % 16 == 15)
+					std::this_thread::yield();
+			}
+
+			lock.lock();
+			if (q.empty() && !isClosed.load(std::memory_order_relaxed))
+			{
+				++sleepers;
+				auto ready = [this]() { return !q.empty() || isClosed.load(std::memory_order_relaxed); };
+				if (deadline)
+					notEmpty.wait_until(lock, *deadline, ready);
+				else
+					notEmpty.wait(lock, ready);
+				--sleepers;
+			}
+			return !q.empty();
+		}
+
+		//pop the front into out, the lock must be held and q must not be empty
+		void take(T &out)
+		{
+			q.pop_bulk(&out, 1);
+			count.store(q.size(), std::memory_order_relaxed);
+		}
+
+	public:
+		blocking_queue() :
+			count(0),
+			isClosed(false),
+			sleepers(0),
+			spinLimit(std::thread::hardware_concurrency() > 1 ? 1024 : 0)
+		{}
+
+		blocking_queue(const blocking_queue &) = delete;
+		blocking_queue& operator=(const blocking_queue &) = delete;
+
+		//append an element and wake up a sleeping consumer.
+		//throw runtime_error if the queue has been closed
+		void push(const T &value)
+		{
+			std::unique_lock<std::mutex> lock(m);
+			if (isClosed.load(std::memory_order_relaxed))
+				throw runtime_error();
+
+			q.push(value);
+			count.store(q.size(), std::memory_order_relaxed);
+			const bool wake = sleepers > 0;
+			lock.unlock();
+
+			if (wake)
+				notEmpty.notify_one();
+		}
+
+		//return false at once if the queue is empty
+		bool try_pop(T &out)
+		{
+			if (count.load(std::memory_order_relaxed) == 0)
+				return false;
+
+			std::lock_guard<std::mutex> lock(m);
+			if (q.empty())
+				return false;
+
+			take(out);
+			return true;
+		}
+
+		//wait until there is an element. return false if the queue is closed and drained
+		bool pop(T &out)
+		{
+			std::unique_lock<std::mutex> lock(m, std::defer_lock);
+			if (!waitForElement(lock, nullptr))
+				return false;
+
+			take(out);
+			return true;
+		}
+
+		//wait at most timeout for an element. return false if there is none by then,
+		//or if the queue is closed and drained
+		template<typename Rep, typename Period>
+		bool pop(T &out, const std::chrono::duration<Rep, Period> &timeout)
+		{
+			const clock::time_point deadline = clock::now() + std::chrono::duration_cast<clock::duration>(timeout);
+			std::unique_lock<std::mutex> lock(m, std::defer_lock);
+			if (!waitForElement(lock, &deadline))
+				return false;
+
+			take(out);
+			return true;
+		}
+
+		//wait until there is an element, then move as many as max elements into out under one lock.
+		//return the number of popped elements, which is 0 only if the queue is closed and drained
+		template<typename OutputIt>
+		size_t pop_bulk(OutputIt out, size_t max)
+		{
+			std::unique_lock<std::mutex> lock(m, std::defer_lock);
+			if (max == 0 || !waitForElement(lock, nullptr))
+				return 0;
+
+			const size_t cnt = q.pop_bulk(out, max);
+			count.store(q.size(), std::memory_order_relaxed);
+			return cnt;
+		}
+
+		//refuse further pushes and wake up all the consumers, which still pop the elements left
+		void close()
+		{
+			{
+				std::lock_guard<std::mutex> lock(m);
+				isClosed.store(true, std::memory_order_relaxed);
+			}
+			notEmpty.notify_all();
+		}
+
+		bool closed() const
+		{
+			return isClosed.load(std::memory_order_relaxed);
+		}
+
+		//only a snapshot when other threads are working on the queue
+		size_t size_approx() const
+		{
+			return count.load(std::memory_order_relaxed);
+		}
+	};
+
+	//a relaxed priority queue for any number of threads (MultiQueue), spread over c * threads sequential heaps.
+	//Each heap sits in its own cache line with a try-lock, and a thread never waits for a lock held by another:
+	//a push goes to a random heap, and a pop locks two random heaps and takes the better of their tops.
+	//So a pop doesn't always return the greatest element, but one whose rank is expected to be about the number of heaps.
+	template<typename T, class Compare = std::less<T>, typename HeapTypeDef = binary_heap<T, Compare>>
+	class multi_queue
+	{
+	private:
+		struct alignas(64) shard
+		{
+			std::atomic<bool> busy;
+			std::atomic<size_t> count;//size of heap, written under the lock
+			HeapTypeDef heap;
+
+			explicit shard(const Compare &x) : busy(false), count(0), heap(x) {}
+
+			//a shard is Lockable, so that std::unique_lock releases it on exceptions
+			bool try_lock()
+			{
+				return !busy.load(std::memory_order_relaxed) && !busy.exchange(true, std::memory_order_acquire);
+			}
+
+			void lock()
+			{
+				while (!try_lock())
+					std::this_thread::yield();
+			}
+
+			void unlock()
+			{
+				busy.store(false, std::memory_order_release);
+			}
+		};
+
+		void *block;//the allocation, shards starts at its first cache line boundary
+		shard *shards;
+		size_t n;
+		Compare cmp;
+
+		//xorshift on a seed of each thread, the high 32 bits are scaled into [0, range)
+		static size_t random(size_t range)
+		{
+			static std::atomic<uint64_t> seeds(0x9E3779B97F4A7C15ULL);
+			static thread_local uint64_t state = 0;
+			if (state == 0)
+				state = seeds.fetch_add(0x9E3779B97F4A7C15ULL, std::memory_order_relaxed) | 1;
+
+			state ^= state >> 12;
+			state ^= state << 25;
+			state ^= state >> 27;
+			return (size_t)(((state * 2685821657736338717ULL) >> 32) * range >> 32);
+		}
+
+		//move the top of a locked shard into out
+		void take(shard &s, T &out)
+		{
+			out = s.heap.front();
+			s.heap.pop_front();
+			s.count.store(s.heap.size(), std::memory_order_relaxed);
+		}
+
+		//the two chosen heaps are empty: look through all of them, starting at a random one.
+		//The heaps locked by other threads are skipped, and looked through again if none is found.
+		//return false if every heap has been seen empty
+		bool popAny(T &out)
+		{
+			for (;;)
+			{
+				const size_t start = random(n);
+				bool skipped = false;
+				for (size_t i = 0; i < n; i++)
+				{
+					shard &s = shards[(start + i) % n];
+					if (s.count.load(std::memory_order_relaxed) == 0)
+						continue;
+
+					std::unique_lock<shard> lock(s, std::try_to_lock);
+					if (!lock)
+					{
+						skipped = true;
+						continue;
+					}
+
+					if (!s.heap.empty())
+					{
+						take(s, out);
+						return true;
+					}
+				}
+
+				if (!skipped)
+					return false;
+			}
+		}
+
+	public:
+		//threads is the number of threads expected to use the queue, and there are c heaps for each of them
+		explicit multi_queue(size_t threads = std::thread::hardware_concurrency(), size_t c = 2, const Compare &x = Compare()) :
+			n(threads * c < 2 ? 2 : threads * c),
+			cmp(x)
+		{
+			block = std::malloc((n + 1) * sizeof(shard));
+			if (block == nullptr)
+				throw std::bad_alloc();
+
+			shards = (shard *)(((uintptr_t)block + cache_line_size - 1) & ~(uintptr_t)(cache_line_size - 1));
+			for (size_t i = 0; i < n; i++)
+				new (shards + i) shard(cmp);
+		}
+
+		multi_queue(const multi_queue &) = delete;
+		multi_queue& operator=(const multi_queue &) = delete;
+
+		//should not be called when other threads are still using the queue
+		~multi_queue()
+		{
+			for (size_t i = 0; i < n; i++)
+				shards[i].~shard();
+
+			std::free(block);
+		}
+
+		//push into a random heap, skipping the ones locked by other threads
+		void push(const T &value)
+		{
+			for (;;)
+			{
+				shard &s = shards[random(n)];
+				std::unique_lock<shard> lock(s, std::try_to_lock);
+				if (!lock)
+					continue;
+
+				s.heap.push_back(value);
+				s.count.store(s.heap.size(), std::memory_order_relaxed);
+				return;
+			}
+		}
+
+		//pop the better top of two random heaps into out.
+		//return false if the queue is empty, which is only a snapshot when other threads are pushing
+		bool try_pop(T &out)
+		{
+			for (;;)
+			{
+				const size_t i = random(n);
+				const size_t j = (i + 1 + random(n - 1)) % n;
+				shard &a = shards[i], &b = shards[j];
+				if (a.count.load(std::memory_order_relaxed) == 0 && b.count.load(std::memory_order_relaxed) == 0)
+					return popAny(out);
+
+				std::unique_lock<shard> lockA(a, std::try_to_lock);
+				if (!lockA)
+					continue;
+				std::unique_lock<shard> lockB(b, std::try_to_lock);
+				if (!lockB)
+					continue;
+
+				if (a.heap.empty() && b.heap.empty())
+					continue;
+
+				if (b.heap.empty() || (!a.heap.empty() && !cmp(a.heap.front(), b.heap.front())))
+					take(a, out);
+				else
+					take(b, out);
+				return true;
+			}
+		}
+
+		//only a snapshot when other threads are working on the queue
+		size_t size_approx() const
+		{
+			size_t sum = 0;
+			for (size_t i = 0; i < n; i++)
+				sum += shards[i].count.load(std::memory_order_relaxed);
+			return sum;
+		}
+
+		bool empty() const
+		{
+			return size_approx() == 0;
+		}
+
+		//the number of heaps
+		size_t heaps() const
+		{
+			return n;
+		}
+	};
+}
+
+#endif
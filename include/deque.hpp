@@ -7,23 +7,63 @@
 #include <cstddef>
 #include <cstring>
 #include <cmath>
+#include <utility>
+#include <type_traits>
 
 namespace sjtu
 {
+//Block size policies of deque, block_size<T>(n) is the target number of elements in a block
+//when the deque holds n elements. A block holds at least two elements, a smaller size is taken as 2.
+//The default one keeps both the number of blocks and their length around sqrt(n).
+struct sqrt_block_policy
+{
+	template<class T>
+	static size_t block_size(size_t n)
+	{
+		const size_t len = (size_t)std::ceil(std::sqrt(n));
+		return len < 2 ? 2 : len;
+	}
+};
+
+//blocks of a fixed number of bytes, e.g. fixed_bytes_block_policy<4096> for 4 KiB blocks
+template<size_t Bytes>
+struct fixed_bytes_block_policy
+{
+	template<class T>
+	static size_t block_size(size_t)
+	{
+		return 2 * sizeof(T) < Bytes ? Bytes / sizeof(T) : 2;
+	}
+};
+
+//blocks of a fixed number of elements
+template<size_t N>
+struct fixed_elements_block_policy
+{
+	static_assert(N >= 2, "a block holds at least two elements, so that a full block can be split");
+
+	template<class T>
+	static size_t block_size(size_t)
+	{
+		return N;
+	}
+};
+
 //std::deque,ڿ״ʵ
 //ȷdequeеnodevalidLen>=1,validLen=0node(last)
-template<class T>
+template<class T, class BlockPolicy = sqrt_block_policy>
 class deque
 {
 private:
 	class node
 	{
-		friend class deque<T>;
+		friend class deque;
 
 	private:
 		node *prev, *next;
 		T *start, *left;
 		size_t totalLen, validLen;
+		size_t rank;//1-based position of this node inside the block_index
 
 		void exchange(node &rhs)
 		{
@@ -33,6 +73,7 @@ private:
 			std::swap(left, rhs.left);
 			std::swap(totalLen, rhs.totalLen);
 			std::swap(validLen, rhs.validLen);
+			std::swap(rank, rhs.rank);
 		}
 
 	public:
@@ -42,7 +83,8 @@ private:
 			start(nullptr),
 			left(nullptr),
 			totalLen(_len),
-			validLen(0)
+			validLen(0),
+			rank(0)
 		{
 			if (_len > 0)
 				left = start = (T *)std::malloc(_len * sizeof(T));//ע⣺ȻmallocĲΪ0Ӧ
@@ -54,7 +96,8 @@ private:
 			start(nullptr),
 			left(nullptr),
 			totalLen(rhs.validLen),
-			validLen(rhs.validLen)
+			validLen(rhs.validLen),
+			rank(0)
 		{
 			if (validLen > 0)
 			{
@@ -90,6 +133,95 @@ private:
 			return left ? left + validLen - 1 : nullptr;
 		}
 
+		//number of free slots before left and after the last element
+		size_t frontRoom() const
+		{
+			return left - start;
+		}
+
+		size_t backRoom() const
+		{
+			return totalLen - (left - start) - validLen;
+		}
+
+		//move cnt elements from src to dst and destroy the original ones, the ranges may overlap.
+		//trivially copyable types are relocated by memmove, others are move constructed one by one.
+		static void transfer(T *dst, T *src, size_t cnt)
+		{
+			if (dst == src || cnt == 0)
+				return;
+
+			transfer(dst, src, cnt, std::integral_constant<bool, std::is_trivially_copyable<T>::value>());
+		}
+
+		static void transfer(T *dst, T *src, size_t cnt, std::true_type)
+		{
+			std::memmove((void *)dst, (const void *)src, cnt * sizeof(T));
+		}
+
+		static void transfer(T *dst, T *src, size_t cnt, std::false_type)
+		{
+			if (dst < src)
+			{
+				for (size_t i = 0; i < cnt; i++)
+				{
+					new (dst + i) T(std::move(*(src + i)));
+					(src + i)->~T();
+				}
+			}
+			else
+			{
+				for (size_t i = cnt; i > 0; i--)
+				{
+					new (dst + i - 1) T(std::move(*(src + i - 1)));
+					(src + i - 1)->~T();
+				}
+			}
+		}
+
+		//merge the adjacent nodes a-b into one node, return the remaining one.
+		//the array of a or b is reused if it has enough room on the proper side,
+		//otherwise a new node with len slots is created.
+		static node* join(node *a, node *b, size_t len)
+		{
+			const size_t total = a->validLen + b->validLen;
+			node *ans = nullptr;
+
+			if (a->backRoom() >= b->validLen)
+			{
+				transfer(a->left + a->validLen, b->left, b->validLen);
+				ans = a;
+			}
+			else if (b->frontRoom() >= a->validLen)
+			{
+				transfer(b->left - a->validLen, a->left, a->validLen);
+				b->left -= a->validLen;
+				ans = b;
+			}
+			else
+			{
+				ans = new node(len > total ? len : total);
+				transfer(ans->left, a->left, a->validLen);
+				transfer(ans->left + a->validLen, b->left, b->validLen);
+			}
+
+			link(a->prev, b->next);
+			insert(ans, b->next);
+			if (a != ans)
+			{
+				a->validLen = 0;
+				delete a;
+			}
+			if (b != ans)
+			{
+				b->validLen = 0;
+				delete b;
+			}
+
+			ans->validLen = total;
+			return ans;
+		}
+
 		//b֮ǰa
 		static void insert(node *a, node *b)
 		{
@@ -130,8 +262,8 @@ private:
 				size_t cnt = remain >= len ? len : remain;
 
 				node *tmp = new node(len);
-				for (auto i = 0; i < cnt; i++)
-					new (tmp->left + i) T(*(start->left + cur++));
+				transfer(tmp->left, start->left + cur, cnt);
+				cur += cnt;
 				
 				tmp->validLen = cnt;
 				insert(tmp, start->next);
@@ -139,6 +271,7 @@ private:
 			}
 
 			node *ans = start->next->prev;
+			start->validLen = 0;//elements have been moved out
 			delete start;
 			return ans;
 		}
@@ -163,8 +296,11 @@ private:
 			//create new node containing all the elements
 			node *tmp = new node(len);
 			for (auto t = p; t != q; t = t->next)
-				for (auto i = 0; i < t->validLen; i++)
-					new (tmp->left + tmp->validLen++) T(*(t->left + i));
+			{
+				transfer(tmp->left + tmp->validLen, t->left, t->validLen);
+				tmp->validLen += t->validLen;
+				t->validLen = 0;
+			}
 
 			//ɾмڵ
 			node *r = p;
@@ -181,15 +317,269 @@ private:
 		}
 	};
 
-	size_t elemCnt;
+	//Fenwick tree over the sizes of the blocks, kept in list order.
+	//It turns position->block and block->position lookups into O(log(B)) operations.
+	//The blocks sit in a sparse array of slots: a spare slot counts as an empty block,
+	//and a rebuild leaves spare slots in front of the first block and after every block.
+	//Thus changing the length of a block, adding or removing a block at either end,
+	//splitting a block and merging two adjacent ones all cost O(log(B)).
+	//Only the changes that run out of spare slots, or touch many blocks at once,
+	//mark it dirty, and the O(B) rebuild is postponed until the next lookup.
+	class block_index
+	{
+		friend class deque;
+
+	private:
+		node **blocks;//blocks[i-1] is the node whose rank is i, or nullptr for a spare slot
+		size_t *tree;//tree[1..hi], tree[0] is unused
+		size_t hi, cap;//slots after hi are all spare, and there are cap-1 slots in total
+		bool dirty;
+
+		static size_t lowbit(size_t i)
+		{
+			return i & (~i + 1);
+		}
+
+		//total length of the slots 1..r
+		size_t sum(size_t r) const
+		{
+			size_t ans = 0;
+			for (; r > 0; r -= lowbit(r))
+				ans += tree[r];
+			return ans;
+		}
+
+		void add(size_t r, size_t delta)//delta may be a wrapped negative value
+		{
+			for (; r <= hi; r += lowbit(r))
+				tree[r] += delta;
+		}
+
+		//put q into the spare slot r, where r <= hi
+		void place(size_t r, node *q)
+		{
+			blocks[r - 1] = q;
+			q->rank = r;
+			add(r, q->validLen);
+		}
+
+		//turn slot r into a spare one, and drop the spare slots at the tail
+		void release(size_t r)
+		{
+			add(r, sum(r - 1) - sum(r));
+			blocks[r - 1] = nullptr;
+			while (hi > 0 && !blocks[hi - 1])
+				--hi;
+		}
+
+	public:
+		block_index() :
+			blocks(nullptr),
+			tree(nullptr),
+			hi(0),
+			cap(0),
+			dirty(true)
+		{}
+
+		block_index(const block_index &) = delete;
+		block_index& operator=(const block_index &) = delete;
+
+		~block_index()
+		{
+			std::free(blocks);
+			std::free(tree);
+		}
+
+		void invalidate()
+		{
+			dirty = true;
+		}
+
+		//re-number all the blocks and build the tree in O(B).
+		//With B blocks, B+1 spare slots are left in front and B+1 at the tail.
+		void rebuild(node *terminal)
+		{
+			size_t cnt = 0;
+			for (node *p = terminal->next; p != terminal; p = p->next)
+				++cnt;
+
+			if (4 * cnt + 3 > cap)
+			{
+				std::free(blocks);
+				std::free(tree);
+				cap = 2 * (4 * cnt + 3);
+				blocks = (node **)std::malloc(cap * sizeof(node *));
+				tree = (size_t *)std::malloc(cap * sizeof(size_t));
+			}
+
+			hi = cnt == 0 ? 0 : 3 * cnt;
+			for (size_t i = 1; i <= hi; i++)
+			{
+				blocks[i - 1] = nullptr;
+				tree[i] = 0;
+			}
+
+			size_t i = cnt + 2;
+			for (node *p = terminal->next; p != terminal; p = p->next, i += 2)
+			{
+				blocks[i - 1] = p;
+				p->rank = i;
+				tree[i] = p->validLen;
+			}
+
+			for (i = 1; i <= hi; i++)
+			{
+				size_t j = i + lowbit(i);
+				if (j <= hi)
+					tree[j] += tree[i];
+			}
+
+			dirty = false;
+		}
+
+		//node p has been appended to the tail of the list
+		void append(node *p)
+		{
+			if (dirty || hi + 2 > cap)
+			{
+				dirty = true;
+				return;
+			}
+
+			const size_t i = ++hi;
+			blocks[i - 1] = p;
+			p->rank = i;
+
+			//tree[i] covers (i-lowbit(i),i]
+			size_t s = p->validLen;
+			for (size_t j = i - 1, stop = i - lowbit(i); j > stop; j -= lowbit(j))
+				s += tree[j];
+			tree[i] = s;
+		}
+
+		//node p has been inserted in front of node q, which can be the terminal
+		void insert_before(node *terminal, node *q, node *p)
+		{
+			if (dirty)
+				return;
+			if (q == terminal)
+				append(p);
+			else if (q->rank > 1 && !blocks[q->rank - 2])
+				place(q->rank - 1, p);
+			else
+				dirty = true;
+		}
+
+		//node q has been split from the tail of node p, whose length has been reduced
+		void split(node *p, node *q)
+		{
+			if (dirty)
+				return;
+
+			add(p->rank, sum(p->rank - 1) + p->validLen - sum(p->rank));
+			if (p->rank == hi)
+				append(q);
+			else if (!blocks[p->rank])
+				place(p->rank + 1, q);
+			else
+				dirty = true;
+		}
+
+		//node p is about to be removed from the list
+		void remove(const node *p)
+		{
+			if (!dirty)
+				release(p->rank);
+		}
+
+		//the adjacent nodes a-b are about to be merged, into the slot of a.
+		//Call replace() with the rank of a once the merged node is known.
+		void join(const node *a, const node *b)
+		{
+			if (dirty)
+				return;
+
+			add(a->rank, sum(b->rank) - sum(b->rank - 1));
+			release(b->rank);
+		}
+
+		//the node with given rank has been replaced by q, which has the same length
+		void replace(size_t rank, node *q)
+		{
+			q->rank = rank;
+			if (!dirty)
+				blocks[rank - 1] = q;
+		}
+
+		//the length of block p has been changed by delta
+		void adjust(const node *p, size_t delta)//delta may be a wrapped negative value
+		{
+			if (!dirty)
+				add(p->rank, delta);
+		}
+
+		//whether p is a block in the list, p must not be the terminal.
+		//O(1) unless a rebuild is pending.
+		bool contains(node *terminal, const node *p)
+		{
+			if (dirty)
+				rebuild(terminal);
+
+			return p->rank >= 1 && p->rank <= hi && blocks[p->rank - 1] == p;
+		}
+
+		//number of elements stored before block p, p can be the terminal
+		size_t prefix(node *terminal, const node *p)
+		{
+			if (dirty)
+				rebuild(terminal);
+
+			return sum(p == terminal ? hi : p->rank - 1);
+		}
+
+		//find the block containing the element with given index,
+		//pos is turned into the offset inside that block.
+		//return terminal if pos is beyond the last element.
+		node* locate(node *terminal, size_t &pos)
+		{
+			if (dirty)
+				rebuild(terminal);
+
+			size_t step = 1, idx = 0;
+			while (2 * step <= hi)
+				step *= 2;
+
+			for (; step > 0; step /= 2)
+			{
+				if (idx + step <= hi && tree[idx + step] <= pos)
+				{
+					idx += step;
+					pos -= tree[idx];
+				}
+			}
+
+			return idx < hi ? blocks[idx] : terminal;
+		}
+	};
+
+	//number of empty nodes kept for reuse by default
+	static const size_t defaultCacheLimit = 4;
+
+	size_t elemCnt, blockCnt;
 	node *last;
-	bool *needMaintain;
+	block_index *index;
+	node *pool;//empty nodes kept for reuse, linked by next
+	size_t poolCnt, poolLimit;
 
 	void exchange(deque &rhs)
 	{
 		std::swap(elemCnt, rhs.elemCnt);
+		std::swap(blockCnt, rhs.blockCnt);
 		std::swap(last, rhs.last);
-		std::swap(needMaintain, rhs.needMaintain);
+		std::swap(index, rhs.index);
+		std::swap(pool, rhs.pool);
+		std::swap(poolCnt, rhs.poolCnt);
+		std::swap(poolLimit, rhs.poolLimit);
 	}
 
 public:
@@ -197,40 +587,26 @@ public:
 	class iterator
 	{
 		friend class const_iterator;
-		friend class deque<T>;
+		friend class deque;
 
 	private:
-		deque<T> *ascription;
+		deque *ascription;
 		node *origin;
 		T *cur;
 
 	public:
 		//constructor
-		iterator(deque<T> *_a = nullptr, node *_ori = nullptr, T *_cur = nullptr) :
+		iterator(deque *_a = nullptr, node *_ori = nullptr, T *_cur = nullptr) :
 			ascription(_a),
 			origin(_ori),
 			cur(_cur)
 		{}
 
-		iterator(deque<T> *_a, size_t index) :
+		iterator(deque *_a, size_t index) :
 			ascription(_a),
-			origin(_a->last),
-			cur(nullptr)
-		{
-			node *terminal = ascription->last;
-			node *p = terminal->next;
-			while (p != terminal && index >= p->validLen)
-			{
-				index -= p->validLen;
-				p = p->next;
-			}
-
-			if (p != terminal)
-			{
-				origin = p;
-				cur = p->left + index;
-			}
-		}
+			origin(_a->index->locate(_a->last, index)),
+			cur(origin == _a->last ? nullptr : origin->left + index)
+		{}
 
 		iterator(const iterator &rhs) :
 			ascription(rhs.ascription),
@@ -238,6 +614,14 @@ public:
 			cur(rhs.cur)
 		{}
 
+		iterator& operator=(const iterator &rhs)
+		{
+			ascription = rhs.ascription;
+			origin = rhs.origin;
+			cur = rhs.cur;
+			return *this;
+		}
+
 		// return the distance between two iterator,
 		// if these two iterators point to different deque, throw invaild_iterator.
 		int operator-(const iterator &rhs) const
@@ -270,29 +654,44 @@ public:
 			else
 			{
 				//Semantics:ƶnЧstepƶend()Ƿ
-				while (origin != ascription->last)
+				//Ŀλڱnodeһnodeʱֱƶ,Ҳoperator++ĳ
+				int step = n;
+				auto p = origin;
+				auto c = cur;
+				for (int k = 0; k < 2 && p != ascription->last; k++)
 				{
-					//nodeʣĿɴӵǰλǰĲ
-					//whileе֤origin->left!=nullptr
-					int curRemainCnt = origin->validLen - (cur - origin->left) - 1;
+					int curRemainCnt = p->validLen - (c - p->left) - 1;
 
-					if (n <= curRemainCnt)//ڱnodeڲ
+					if (step <= curRemainCnt)//ڱnodeڲ
 					{
-						cur += n;
+						origin = p;
+						cur = c + step;
 						return *this;
 					}
 					else//ƶһnodeĵһ
 					{
-						n -= (curRemainCnt + 1);
-						origin = origin->next;
-						cur = origin->left;
+						step -= (curRemainCnt + 1);
+						p = p->next;
+						c = p->left;
 					}
 				}
 
-				if (n != 0)//end()ҲΪյ㣬invalid
-					throw invalid_iterator();
-				else
+				if (p == ascription->last)
+				{
+					if (step != 0)//end()ҲΪյ㣬invalid
+						throw invalid_iterator();
+
+					origin = p;
+					cur = nullptr;
 					return *this;
+				}
+
+				//block_indexֱӶλ
+				const size_t target = getIndex() + n;
+				if (target > ascription->elemCnt)
+					throw invalid_iterator();
+
+				return *this = iterator(ascription, target);
 			}
 		}
 
@@ -305,25 +704,22 @@ public:
 			else
 			{
 				//Semantics: ƶһ֮end(),invalidܿԽbegin()
-				do {
-					//ǰʣĿǰĲ[left,cur)֮Ԫظ
-					//ע⣺nullptrֻڱȽϣ
-					int frontLeftCnt = cur ? cur - origin->left : 0;
+				//ǰʣĿǰĲ[left,cur)֮Ԫظ
+				//ע⣺nullptrֻڱȽϣ
+				int frontLeftCnt = cur ? cur - origin->left : 0;
 
-					if (n <= frontLeftCnt)
-					{
-						cur -= n;
-						return *this;
-					}
-					else
-					{
-						n -= frontLeftCnt;
-						origin = origin->prev;
-						cur = origin->left ? origin->left + origin->validLen : nullptr;
-					}
-				} while (origin != ascription->last);
+				if (n <= frontLeftCnt)
+				{
+					cur -= n;
+					return *this;
+				}
+
+				//Խnodeʱblock_indexֱӶλ
+				const int target = getIndex() - n;
+				if (target < 0)//Խbegin
+					throw invalid_iterator();
 
-				throw invalid_iterator();//е˴ȻǿԽbegin
+				return *this = iterator(ascription, (size_t)target);
 			}
 		}
 
@@ -405,20 +801,8 @@ public:
 				return false;
 			
 			//OK, they now point to the same deque.
-			//originǷ
-			node *terminal = ascription->last;
-			node *p = terminal;
-			bool exist = false;
-
-			do {
-				if (p == origin)
-				{
-					exist = true;
-					break;
-				}
-				p = p->next;
-			} while (p != terminal);
-			if (!exist)
+			//originǷڣblock_index
+			if (origin != ascription->last && !ascription->index->contains(ascription->last, origin))
 				return false;
 
 			//OK, the node that origin pointing to exists.
@@ -435,61 +819,41 @@ public:
 		}
 
 	private:
+		//O(log(B)) with the help of block_index
 		int getIndex() const
 		{
-			int cnt = 0;
-			node *p = ascription->last->next;
-			
-			while (p != origin)
-			{
-				cnt += p->validLen;
-				p = p->next;
-			}
+			int cnt = ascription->index->prefix(ascription->last, origin);
 
-			if (p == ascription->last)
+			if (origin == ascription->last)
 				return cnt;
 			else
-				return cnt + (cur - p->left);
+				return cnt + (cur - origin->left);
 		}
 	};
 
 	class const_iterator
 	{
 		friend class iterator;
-		friend class deque<T>;
+		friend class deque;
 
 	private:
-		const deque<T> *ascription;
+		const deque *ascription;
 		const node *origin;
 		const T *cur;
 
 	public:
 		//constructor
-		const_iterator(const deque<T> *_a = nullptr, const node *_ori = nullptr, const T *_cur = nullptr) :
+		const_iterator(const deque *_a = nullptr, const node *_ori = nullptr, const T *_cur = nullptr) :
 			ascription(_a),
 			origin(_ori),
 			cur(_cur)
 		{}
 
-		const_iterator(const deque<T> *_a, size_t index) :
+		const_iterator(const deque *_a, size_t index) :
 			ascription(_a),
-			origin(_a->last),
-			cur(nullptr)
-		{
-			node *terminal = ascription->last;
-			node *p = terminal->next;
-			while (p != terminal && index >= p->validLen)
-			{
-				index -= p->validLen;
-				p = p->next;
-			}
-
-			if (p != terminal)
-			{
-				origin = p;
-				cur = p->left + index;
-			}
-		}
+			origin(_a->index->locate(_a->last, index)),
+			cur(origin == _a->last ? nullptr : origin->left + index)
+		{}
 
 		const_iterator(const iterator &rhs) :
 			ascription(rhs.ascription),
@@ -503,6 +867,14 @@ public:
 			cur(rhs.cur)
 		{}
 
+		const_iterator& operator=(const const_iterator &rhs)
+		{
+			ascription = rhs.ascription;
+			origin = rhs.origin;
+			cur = rhs.cur;
+			return *this;
+		}
+
 		// return the distance between two iterator,
 		// if these two iterators point to different deque, throw invaild_iterator.
 		int operator-(const const_iterator &rhs) const
@@ -535,29 +907,44 @@ public:
 			else
 			{
 				//Semantics:ƶnЧstepƶend(),throw invalid_iterator()
-				while (origin != ascription->last)
+				//Ŀλڱnodeһnodeʱֱƶ,Ҳoperator++ĳ
+				int step = n;
+				auto p = origin;
+				auto c = cur;
+				for (int k = 0; k < 2 && p != ascription->last; k++)
 				{
-					//nodeʣĿɴӵǰλǰĲ,while ֤origin->left!=nullptr
-					int curRemainCnt = origin->validLen - (cur - origin->left) - 1;
+					int curRemainCnt = p->validLen - (c - p->left) - 1;
 
-					if (n <= curRemainCnt)//ڱnodeڲ
+					if (step <= curRemainCnt)//ڱnodeڲ
 					{
-						cur += n;
+						origin = p;
+						cur = c + step;
 						return *this;
 					}
 					else//ƶһnodeĵһ
 					{
-						n -= (curRemainCnt + 1);
-						origin = origin->next;
-						cur = origin->left;
+						step -= (curRemainCnt + 1);
+						p = p->next;
+						c = p->left;
 					}
 				}
 
-				//end()ҲΪյ㣬invalid
-				if (n != 0)
-					throw invalid_iterator();
-				else
+				if (p == ascription->last)
+				{
+					if (step != 0)//end()ҲΪյ㣬invalid
+						throw invalid_iterator();
+
+					origin = p;
+					cur = nullptr;
 					return *this;
+				}
+
+				//block_indexֱӶλ
+				const size_t target = getIndex() + n;
+				if (target > ascription->elemCnt)
+					throw invalid_iterator();
+
+				return *this = const_iterator(ascription, target);
 			}
 		}
 
@@ -570,27 +957,22 @@ public:
 			else
 			{
 				//Semantics: ƶһ֮end(),invalidܿԽbegin()
-				do {
-					//ǰʣĿǰĲ
-					//ע⣺nullptrֻڱȽϣ
-					int frontLeftCnt = cur ? cur - origin->left : 0;
+				//ǰʣĿǰĲ[left,cur)֮Ԫظ
+				//ע⣺nullptrֻڱȽϣ
+				int frontLeftCnt = cur ? cur - origin->left : 0;
 
-					if (n <= frontLeftCnt)
-					{
-						cur -= n;
-						return *this;
-					}
-					else
-					{
-						n -= frontLeftCnt;
-						origin = origin->prev;
-						cur = origin->left ? origin->left + origin->validLen : nullptr;
-					}
+				if (n <= frontLeftCnt)
+				{
+					cur -= n;
+					return *this;
+				}
 
-				} while (origin != ascription->last);
+				//Խnodeʱblock_indexֱӶλ
+				const int target = getIndex() - n;
+				if (target < 0)//Խbegin
+					throw invalid_iterator();
 
-				//е˴ȻǿԽbegin
-				throw invalid_iterator();
+				return *this = const_iterator(ascription, (size_t)target);
 			}
 		}
 
@@ -673,20 +1055,8 @@ public:
 				return false;
 
 			//OK, they now point to the same deque.
-			//originǷ
-			node *terminal = ascription->last;
-			node *p = terminal;
-			bool exist = false;
-
-			do {
-				if (p == origin)
-				{
-					exist = true;
-					break;
-				}
-				p = p->next;
-			} while (p != terminal);
-			if (!exist)
+			//originǷڣblock_index
+			if (origin != ascription->last && !ascription->index->contains(ascription->last, origin))
 				return false;
 
 			//OK, the node that origin pointing to exists.
@@ -703,34 +1073,36 @@ public:
 		}
 
 	private:
+		//O(log(B)) with the help of block_index
 		int getIndex() const
 		{
-			int cnt = 0;
-			node *p = ascription->last->next;
-
-			while (p != origin)
-			{
-				cnt += p->validLen;
-				p = p->next;
-			}
+			int cnt = ascription->index->prefix(ascription->last, origin);
 
-			if (p == ascription->last)
+			if (origin == ascription->last)
 				return cnt;
 			else
-				return cnt + (cur - p->left);
+				return cnt + (cur - origin->left);
 		}
 	};
 
 	deque() :
 		elemCnt(0),
+		blockCnt(0),
 		last(new node()),
-		needMaintain(new bool(false))
+		index(new block_index()),
+		pool(nullptr),
+		poolCnt(0),
+		poolLimit(defaultCacheLimit)
 	{}
 
 	deque(const deque &rhs) :
 		elemCnt(rhs.elemCnt), 
+		blockCnt(0),
 		last(new node()),
-		needMaintain(new bool(false))
+		index(new block_index()),
+		pool(nullptr),
+		poolCnt(0),
+		poolLimit(rhs.poolLimit)
 	{
 		for (node *p = rhs.last->next; p != rhs.last; p = p->next)//deep copy,ֻԪصnode
 			if (p->validLen != 0)
@@ -742,8 +1114,9 @@ public:
 	~deque()
 	{
 		clear();
+		set_cache_limit(0);
 		delete last;
-		delete needMaintain;
+		delete index;
 	}
 
 	deque& operator=(deque other)
@@ -758,7 +1131,6 @@ public:
 		if (pos >= elemCnt)
 			throw index_out_of_bound();
 
-		update();
 		return *(iterator(this, pos));
 	}
     
@@ -767,7 +1139,6 @@ public:
 		if (pos >= elemCnt)
 			throw index_out_of_bound();
 
-		update();
 		return *(const_iterator(this, pos));
 	}
     
@@ -802,26 +1173,22 @@ public:
 	//iterator to the beginning
 	iterator begin()
 	{ 
-		update();
 		return iterator(this, last->next, last->next->left);
 	}
 
 	const_iterator cbegin() const
 	{ 
-		update();
 		return const_iterator(this, last->next, last->next->left);
 	}
 
 	//iterator to the end
 	iterator end()
 	{
-		update();
 		return iterator(this, last, nullptr);
 	}
 
 	const_iterator cend() const
 	{ 
-		update();
 		return const_iterator(this, last, nullptr);
 	}
 
@@ -837,6 +1204,25 @@ public:
 		return elemCnt; 
 	}
 
+	//at most n empty blocks are kept for reuse instead of being released,
+	//so that push and pop at the ends don't allocate memory in a steady state
+	void set_cache_limit(size_t n)
+	{
+		poolLimit = n;
+		while (poolCnt > n)
+		{
+			node *p = pool;
+			pool = p->next;
+			--poolCnt;
+			delete p;
+		}
+	}
+
+	size_t cache_limit() const
+	{
+		return poolLimit;
+	}
+
     //release all the nodes, as well as the contents inside
 	//also, relink the prev and next pointer of last to itself
 	void clear()
@@ -846,10 +1232,11 @@ public:
 		{
 			t = p;
 			p = p->next;
-			delete t;
+			recycle(t);
 		}
 		last->prev = last->next = last;
-		elemCnt = 0;
+		elemCnt = blockCnt = 0;
+		index->invalidate();
 	}
 
 	//inserts value before pos
@@ -858,101 +1245,53 @@ public:
 		if (!pos.isValid(this))
 			throw invalid_iterator();
 
-		++elemCnt;
-
-		if (pos.origin->validLen < pos.origin->totalLen)//ǰnodeп
+		if (pos.origin == last)//end()֮ǰ뼴Ϊpush_back
 		{
-			size_t leftMoveCnt = pos.cur - pos.origin->left;//[left,pos)֮Ԫظ
-			size_t rightMoveCnt = pos.origin->validLen - leftMoveCnt;//[pos,left+validLen)֮Ԫظ
-			size_t leftEmptyCnt = pos.origin->left - pos.origin->start;//߿
-			size_t rightEmptyCnt = pos.origin->totalLen - leftEmptyCnt - pos.origin->validLen;//ұ߿
-			bool moveToLeft = leftEmptyCnt == 0 ? false : (rightEmptyCnt == 0 ? true : leftMoveCnt <= rightMoveCnt);//ȷƶ
+			push_back(value);
+			return iterator(this, last->prev, last->prev->getBackPtr());
+		}
 
-			//move elements
-			if (moveToLeft)
-			{
-				T *dstStart = pos.origin->left - 1;
-				T *srcStart = dstStart + 1;
+		node *p = pos.origin;
+		size_t offset = pos.cur - p->left;
 
-				for (auto i = 0; i < leftMoveCnt; i++)
-				{
-					new (dstStart + i) T(*(srcStart + i));
-					(srcStart + i)->~T();
-				}
+		//nodeĿͷǰһnodeβпʱֱ׷ӵǰһnode
+		if (offset == 0 && p->prev != last && p->prev->backRoom() > 0)
+		{
+			p = p->prev;
+			new (p->left + p->validLen) T(value);
+			++p->validLen;
+			++elemCnt;
+			index->adjust(p, 1);
+			return iterator(this, p, p->getBackPtr());
+		}
 
-				--pos.origin->left;
-				--pos.cur;
-			}
-			else
-			{
-				T *dstStart = pos.origin->left + pos.origin->validLen;
-				T *srcStart = dstStart - 1;
-
-				for (auto i = 0; i < rightMoveCnt; i++)
-				{
-					new (dstStart - i) T(*(srcStart - i));
-					(srcStart - i)->~T();
-				}
-			}
-
-			//insert new value
-			new (pos.cur) T(value);
-			++pos.origin->validLen;
-			return pos;
-		}
-		else//ǰnode,split
+		T copy(value);//value may lie in the node to be reshaped or moved
+		++elemCnt;
+		if (p->validLen == p->totalLen)//ǰnodeֻڱnodeֲݻһΪ
+			p = reshape(p, offset);
+
+		T *cur = p->left + offset;
+		size_t leftMoveCnt = offset;//[left,pos)֮Ԫظ
+		size_t rightMoveCnt = p->validLen - leftMoveCnt;//[pos,left+validLen)֮Ԫظ
+		size_t leftEmptyCnt = p->frontRoom();//߿
+		size_t rightEmptyCnt = p->backRoom();//ұ߿
+		bool moveToLeft = leftEmptyCnt == 0 ? false : (rightEmptyCnt == 0 ? true : leftMoveCnt <= rightMoveCnt);//ȷƶ
+
+		//move elements
+		if (moveToLeft)
 		{
-			node *p = pos.origin;
-			const size_t ansIndex = pos.getIndex();
-
-			size_t leftMoveCnt = pos.cur ? pos.cur - p->left : 0;//[left,pos)֮Ԫظ,posΪend
-			size_t rightMoveCnt = p->validLen - leftMoveCnt;//[pos,left+validLen)֮Ԫظ
-			size_t leftAllocCnt = leftMoveCnt + 1;
-			size_t rightAllocCnt = rightMoveCnt;
-
-			if (leftMoveCnt <= rightMoveCnt)//벿Ԫؽ
-			{
-				node *tmp = new node(leftAllocCnt);
-				node::insert(tmp, p);
-
-				//[left,pos)ԭ
-				for (auto i = 0; i < leftMoveCnt; i++)
-					new (tmp->left + i) T(*(p->left + i));
-
-				//insert value
-				tmp->validLen = leftAllocCnt;
-				new (tmp->left + tmp->validLen - 1) T(value);
-				
-				//ԭnode
-				for (auto i = 0; i < leftMoveCnt; i++)
-				{
-					p->left->~T();//иĶ
-					++p->left;//иĶ
-				}
-				p->validLen -= leftMoveCnt;
-			}
-			else//Ұ벿Ԫؽ
-			{
-				node *tmp = new node(rightAllocCnt);
-				node::insert_after(p, tmp);
-
-				//[pos,left+validCnt)
-				for (auto i = 0; i < rightMoveCnt; i++)
-					new (tmp->left + i) T(*(pos.cur + i));
-				tmp->validLen = rightAllocCnt;
-
-				//
-				for (auto i = 0; i < rightMoveCnt; i++)
-					(pos.cur + i)->~T();
-
-				//insert
-				new (pos.cur) T(value);
-				p->validLen -= (rightMoveCnt - 1);
-			}
-
-			maintain();
-			return  iterator(this, ansIndex);
+			node::transfer(p->left - 1, p->left, leftMoveCnt);
+			--p->left;
+			--cur;
 		}
+		else
+			node::transfer(cur + 1, cur, rightMoveCnt);
+
+		//insert new value
+		new (cur) T(std::move(copy));
+		++p->validLen;
+		index->adjust(p, 1);
+		return iterator(this, p, cur);
 	}
 	
 	//removes specified element at pos
@@ -963,71 +1302,164 @@ public:
 
 		--elemCnt;
 		node *p = pos.origin;
+		size_t offset = pos.cur - p->left;
 
 		if (p->validLen == 1)
 		{
-			node::link(p->prev, p->next);
 			node *t = p->next;
-			delete p;
+			remove(p);
 			return iterator(this, t, t->left);
 		}
-		else
+
+		size_t leftMoveCnt = offset;//[left,pos)֮Ԫظ
+		size_t rightMoveCnt = p->validLen - leftMoveCnt - 1;//(pos,left+validLen)֮Ԫظ
+		pos.cur->~T();
+
+		if (leftMoveCnt < rightMoveCnt)//Ԫؽ٣[left,pos)֮Ԫmoveһλ
+		{
+			node::transfer(p->left + 1, p->left, leftMoveCnt);
+			++p->left;
+		}
+		else//ұԪؽ٣(pos,left+validLen)֮Ԫǰmoveһλ
+			node::transfer(pos.cur, pos.cur + 1, rightMoveCnt);
+
+		--p->validLen;
+		index->adjust(p, (size_t)-1);
+
+		//node̺nodeϲ
+		p = shrink(p, offset);
+		if (offset == p->validLen)
 		{
-			int leftMoveCnt = pos.cur - p->left;//[left,pos)֮Ԫظ
-			int rightMoveCnt = p->validLen - leftMoveCnt - 1;//(pos,left+validLen)֮Ԫظ
+			p = p->next;
+			offset = 0;
+		}
+		return iterator(this, p, p->left ? p->left + offset : nullptr);
+	}
 
-			if (leftMoveCnt < rightMoveCnt)//Ԫؽ٣[left,pos)֮Ԫmoveһλ
-			{
-				T *dstStart = pos.cur;
-				T *srcStart = dstStart - 1;
+	//inserts the elements of [first, last) before pos, return the iterator to the first inserted one
+	template<class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+	iterator insert(iterator pos, InputIt first, InputIt last)
+	{
+		if (!pos.isValid(this))
+			throw invalid_iterator();
 
-				for (auto i = 0; i < leftMoveCnt; i++)
-				{
-					(dstStart - i)->~T();
-					new (dstStart - i) T(*(srcStart - i));
-				}
-				p->left->~T();
+		return insertRange(pos, first, last);
+	}
+
+	//inserts n copies of value before pos, return the iterator to the first inserted one
+	iterator insert(iterator pos, size_t n, const T &value)
+	{
+		if (!pos.isValid(this))
+			throw invalid_iterator();
 
-				++p->left;
-				--p->validLen;
+		const T copy(value);//value may lie in the blocks to be moved
+		return insertRange(pos, fill_iterator(&copy, n), fill_iterator(&copy, 0));
+	}
 
-				++pos.cur;
-				return pos;
-			}
-			else//ұԪؽ٣(pos,left+validLen)֮Ԫǰmoveһλ
-			{
-				T *dstStart = pos.cur;
-				T *srcStart = dstStart + 1;
+	//removes the elements in [first, last), return the iterator following the last removed one.
+	//Only the two blocks at the borders are cut, the ones in between are released as a whole.
+	iterator erase(iterator first, iterator last)
+	{
+		if (!first.isValid(this) || !last.isValid(this))
+			throw invalid_iterator();
 
-				for (auto i = 0; i < rightMoveCnt; i++)
-				{
-					(dstStart + i)->~T();
-					new (dstStart + i) T(*(srcStart + i));
-				}
+		const int from = first.getIndex(), to = last.getIndex();
+		if (from > to)
+			throw invalid_iterator();
+		if (from == to)
+			return iterator(this, (size_t)from);
 
-				--p->validLen;
-				(p->left + p->validLen)->~T();
+		elemCnt -= to - from;
+		node *p = first.origin, *q = last.origin;
+		const size_t offset = first.cur - p->left;
+		node *before = nullptr, *after = nullptr;//neighbours of the gap
 
-				if (pos.cur == p->left + p->validLen)
-				{
-					do { p = p->next; } while (p != last && p->validLen == 0);
-					return iterator(this, p, p->left);
-				}
-				else
-					return pos;
+		if (p == q)//the range lies inside p, close the gap by moving the shorter side
+		{
+			const size_t cnt = to - from;
+			const size_t rightCnt = p->validLen - offset - cnt;
+			for (size_t i = 0; i < cnt; i++)
+				(p->left + offset + i)->~T();
+
+			if (offset < rightCnt)
+			{
+				node::transfer(p->left + cnt, p->left, offset);
+				p->left += cnt;
+			}
+			else
+				node::transfer(p->left + offset, p->left + offset + cnt, rightCnt);
+			p->validLen -= cnt;
+
+			before = p->prev;
+			after = p->next;
+			if (p->validLen == 0)
+			{
+				node::link(before, after);
+				recycle(p);
+				--blockCnt;
+			}
+			else
+				before = after = p;
+		}
+		else
+		{
+			//cut the tail of p, release the nodes in between, then cut the head of q
+			for (size_t i = offset; i < p->validLen; i++)
+				(p->left + i)->~T();
+			p->validLen = offset;
+
+			before = offset > 0 ? p : p->prev;
+			node *t = offset > 0 ? p->next : p;
+			while (t != q)
+			{
+				node *c = t;
+				t = t->next;
+				recycle(c);
+				--blockCnt;
+			}
+
+			if (q != this->last)
+			{
+				const size_t cnt = last.cur - q->left;
+				for (size_t i = 0; i < cnt; i++)
+					(q->left + i)->~T();
+				q->left += cnt;
+				q->validLen -= cnt;
 			}
+			node::link(before, q);
+			after = q;
 		}
+
+		index->invalidate();
+		if (elemCnt > 0)
+			tidy(before, after);
+		rebalance();
+		return iterator(this, (size_t)from);
 	}
 
+
 	//ͷβ
 	void push_back(const T &value)
 	{
-		node *tmp = new node(1);
-		new (tmp->left) T(value);
-		++tmp->validLen;
-		node::insert(tmp, last);
 		++elemCnt;
-		*needMaintain = true;
+		node *p = last->prev;
+
+		if (p == last || p->backRoom() == 0)//βûп࣬½һnode
+		{
+			p = acquire(blockSize());
+			node::insert(p, last);
+			new (p->left) T(value);
+			++p->validLen;
+			index->append(p);
+			++blockCnt;
+			rebalance();
+		}
+		else
+		{
+			new (p->left + p->validLen) T(value);
+			++p->validLen;
+			index->adjust(p, 1);
+		}
 	}
 
 	void pop_back()
@@ -1039,25 +1471,38 @@ public:
 		node *p = last->prev;
 
 		if (p->validLen == 1)
-		{
-			node::link(p->prev, p->next);
-			delete p;
-		}
+			remove(p);
 		else
 		{
 			--p->validLen;
 			(p->left + p->validLen)->~T();
+			index->adjust(p, (size_t)-1);
 		}
 	}
 
 	void push_front(const T &value)
 	{
-		node *tmp = new node(1);
-		new (tmp->left) T(value);
-		++tmp->validLen;
-		node::insert_after(last, tmp);
 		++elemCnt;
-		*needMaintain = true;
+		node *p = last->next;
+
+		if (p == last || p->frontRoom() == 0)//ͷûп࣬½һnodeĩ˿ʼ
+		{
+			p = acquire(blockSize());
+			node::insert_after(last, p);
+			p->left += p->totalLen - 1;
+			new (p->left) T(value);
+			++p->validLen;
+			index->insert_before(last, p->next, p);
+			++blockCnt;
+			rebalance();
+		}
+		else
+		{
+			--p->left;
+			new (p->left) T(value);
+			++p->validLen;
+			index->adjust(p, 1);
+		}
 	}
 
 	void pop_front()
@@ -1069,36 +1514,283 @@ public:
 		node *p = last->next;
 
 		if (p->validLen == 1)
-		{
-			node::link(p->prev, p->next);
-			delete p;
-		}
+			remove(p);
 		else
 		{
 			--p->validLen;
 			p->left->~T();
 			++p->left;
+			index->adjust(p, (size_t)-1);
 		}
 	}
 
 private:
-	//Warpper for maintain
-	void update() const
+	//target length of a node under current size, given by the block policy
+	size_t blockSize() const
+	{
+		const size_t len = BlockPolicy::template block_size<T>(elemCnt);
+		return len < 2 ? 2 : len;
+	}
+
+	//unlink and release node p, which should have been emptied or contains only one element
+	void remove(node *p)
+	{
+		index->remove(p);
+		node::link(p->prev, p->next);
+
+		recycle(p);
+		--blockCnt;
+	}
+
+	//an empty node with about len slots and at least least ones,
+	//taken from the pool if the cached one is not too short
+	node* acquire(size_t len, size_t least = 1)
 	{
-		if (*needMaintain)
+		if (pool)
 		{
-			maintain();
-			*needMaintain = false;
+			node *p = pool;
+			pool = p->next;
+			--poolCnt;
+			if (2 * p->totalLen >= len && p->totalLen >= least)
+			{
+				p->prev = p->next = p;
+				p->left = p->start;
+				return p;
+			}
+			delete p;
+		}
+		return new node(len);
+	}
+
+	//destroy the elements left in node p, then keep it in the pool unless the pool is full
+	void recycle(node *p)
+	{
+		for (size_t i = 0; i < p->validLen; i++)
+			(p->left + i)->~T();
+		p->validLen = 0;
+
+		if (poolCnt < poolLimit)
+		{
+			p->next = pool;
+			pool = p;
+			++poolCnt;
+		}
+		else
+			delete p;
+	}
+
+	//node p is full and one more element is going to be put at offset.
+	//A node shorter than blockSize() is moved into a larger array, otherwise its right half
+	//is moved into a new node. Only p itself is touched, the cost is O(p->validLen).
+	//return the node where offset lies afterwards and fix offset accordingly.
+	node* reshape(node *p, size_t &offset)
+	{
+		const size_t sn = blockSize();
+		const size_t len = p->validLen;
+
+		if (len < sn)
+		{
+			node *tmp = acquire(sn, len + 1);
+			tmp->left += (tmp->totalLen - len) / 2;//˶
+			node::transfer(tmp->left, p->left, len);
+			tmp->validLen = len;
+			p->validLen = 0;
+
+			node::insert(tmp, p);
+			node::link(tmp, p->next);
+			index->replace(p->rank, tmp);
+			recycle(p);
+			return tmp;
+		}
+		else
+		{
+			const size_t half = len / 2;
+			node *tmp = acquire(p->totalLen, len - half + 1);
+			node::transfer(tmp->left, p->left + half, len - half);
+			tmp->validLen = len - half;
+			p->validLen = half;
+
+			node::insert_after(p, tmp);
+			index->split(p, tmp);
+			++blockCnt;
+
+			if (offset <= half)
+				return p;
+
+			offset -= half;
+			return tmp;
+		}
+	}
+
+	//node p has become short: merge it with the shorter neighbour if both of them fit in one node.
+	//Together with reshape(), no two adjacent nodes are shorter than blockSize()/2 after each operation.
+	//return the node where offset lies afterwards and fix offset accordingly.
+	node* shrink(node *p, size_t &offset)
+	{
+		const size_t sn = blockSize();
+		if (2 * p->validLen >= sn)
+			return p;
+
+		node *a = p->prev, *b = p->next;
+		bool toPrev = a != last && (b == last || a->validLen <= b->validLen);
+		node *q = toPrev ? a : b;
+
+		if (q == last || p->validLen + q->validLen > sn)
+			return p;
+
+		--blockCnt;
+		if (toPrev)
+		{
+			offset += a->validLen;
+			b = p;
+		}
+		else
+			a = p;
+
+		const size_t rank = a->rank;
+		index->join(a, b);
+		node *ans = node::join(a, b, sn);
+		index->replace(rank, ans);
+		return ans;
+	}
+
+	//a sequence of n copies of value, used by insert(pos, n, value)
+	class fill_iterator
+	{
+	private:
+		const T *value;
+		size_t remain;
+
+	public:
+		fill_iterator(const T *_value, size_t _remain) :
+			value(_value),
+			remain(_remain)
+		{}
+
+		const T& operator*() const
+		{
+			return *value;
+		}
+
+		fill_iterator& operator++()
+		{
+			--remain;
+			return *this;
+		}
+
+		bool operator!=(const fill_iterator &rhs) const
+		{
+			return remain != rhs.remain;
+		}
+	};
+
+	//p is cut at pos, the elements of [first, last) fill the free slots at the end of the left part
+	//and then new nodes of blockSize(), and the nodes around the seams are merged by tidy() once.
+	//The cost is O(k + blockSize()) for k new elements, other nodes are untouched.
+	template<class InputIt>
+	iterator insertRange(iterator pos, InputIt first, InputIt last)
+	{
+		const size_t at = pos.getIndex();
+		if (!(first != last))
+			return iterator(this, at);
+
+		node *a = nullptr, *b = nullptr;//the new elements go between a and b
+		if (pos.origin == this->last)
+		{
+			a = this->last->prev;
+			b = this->last;
+		}
+		else if (pos.cur == pos.origin->left)
+		{
+			a = pos.origin->prev;
+			b = pos.origin;
+		}
+		else
+		{
+			node *p = pos.origin;
+			const size_t offset = pos.cur - p->left;
+			const size_t tailLen = p->validLen - offset;
+			const size_t sn = blockSize();
+			node *tail = acquire(tailLen > sn ? tailLen : sn, tailLen);
+			node::transfer(tail->left, p->left + offset, tailLen);
+			tail->validLen = tailLen;
+			p->validLen = offset;
+			node::insert_after(p, tail);
+			++blockCnt;
+			a = p;
+			b = tail;
+		}
+
+		node *cur = a;
+		while (first != last)
+		{
+			++elemCnt;
+			if (cur == this->last || cur->backRoom() == 0)
+			{
+				cur = acquire(blockSize());
+				node::insert(cur, b);
+				++blockCnt;
+			}
+			new (cur->left + cur->validLen) T(*first);
+			++cur->validLen;
+			++first;
 		}
+
+		index->invalidate();
+		tidy(a, b);
+		rebalance();
+		return iterator(this, at);
+	}
+
+	//merge the adjacent short nodes from the neighbour before `from` to the neighbour after `to`,
+	//so that no two adjacent nodes are shorter than blockSize()/2 around the changed part.
+	//`from` and `to` may be last, which stands for the first and the last node respectively.
+	void tidy(node *from, node *to)
+	{
+		if (from == last)
+			from = last->next;
+		if (to == last)
+			to = last->prev;
+		if (from->prev != last)
+			from = from->prev;
+		if (to->next != last)
+			to = to->next;
+
+		const size_t sn = blockSize();
+		node *p = from;
+		while (p != to)
+		{
+			node *q = p->next;
+			if ((2 * p->validLen < sn || 2 * q->validLen < sn) && p->validLen + q->validLen <= sn)
+			{
+				const bool end = q == to;
+				p = node::join(p, q, sn);
+				--blockCnt;
+				if (end)
+					break;
+			}
+			else
+				p = q;
+		}
+	}
+
+	//safety net of the local strategy: rebuild all the nodes when there are too many of them,
+	//i.e. far more than elemCnt/blockSize()
+	void rebalance()
+	{
+		const size_t sn = blockSize();
+		if (sn > 0 && blockCnt > 4 * (elemCnt / sn) + 4)
+			maintain();
 	}
 
 	//ɨnode϶̵ĺϲ,ϳĲ
-	void maintain() const
+	void maintain()
 	{
-		const size_t sn = (size_t)std::ceil(std::sqrt(elemCnt));
+		const size_t sn = blockSize();
 		if (sn == 0) 
 			return;
 
+		index->invalidate();
 		node *p = last->next;
 		while (p != last)
 		{
@@ -1109,6 +1801,591 @@ private:
 			else
 				p = p->next;
 		}
+
+		blockCnt = 0;
+		for (p = last->next; p != last; p = p->next)
+			++blockCnt;
+	}
+};
+
+
+//floor(log2(x)), used to compute the block length of fixed_block_deque at compile time
+constexpr size_t _log2_floor(size_t x)
+{
+	return x <= 1 ? 0 : 1 + _log2_floor(x >> 1);
+}
+
+//The classic layout of std::deque: a central map of pointers to fixed-size blocks.
+//Indexing, iterator arithmetic and push/pop at both ends are O(1) (amortised),
+//while insert and erase in the middle move O(min(i, n-i)) elements.
+//The public interface is the same as deque, so it can be used as a drop-in replacement
+//for queue-like workloads, where middle insertion doesn't matter.
+template<class T>
+class fixed_block_deque
+{
+private:
+	//each block holds a power-of-two number of elements in about 4 KiB
+	static const size_t blockShift = _log2_floor(sizeof(T) < 4096 ? 4096 / sizeof(T) : 1);
+	static const size_t blockLen = (size_t)1 << blockShift;
+	static const size_t blockMask = blockLen - 1;
+
+	T **map;//map[i] points to the i-th block, or nullptr if not allocated
+	size_t mapSize;
+	size_t head;//position of the first element, counted from map[0][0]
+	size_t elemCnt;
+
+	void exchange(fixed_block_deque &rhs)
+	{
+		std::swap(map, rhs.map);
+		std::swap(mapSize, rhs.mapSize);
+		std::swap(head, rhs.head);
+		std::swap(elemCnt, rhs.elemCnt);
+	}
+
+	//address of the element with given index
+	T* slot(size_t pos) const
+	{
+		const size_t g = head + pos;
+		return map[g >> blockShift] + (g & blockMask);
+	}
+
+	void allocBlock(size_t b)
+	{
+		if (!map[b])
+			map[b] = (T *)std::malloc(blockLen * sizeof(T));
+	}
+
+	//no free slot at one end of the map: move the blocks in use to the middle of a new map,
+	//whose size is doubled if more than half of the old one is in use.
+	void reallocMap()
+	{
+		const size_t firstBlock = head >> blockShift;
+		const size_t usedBlocks = elemCnt == 0 ? 0 : ((head + elemCnt - 1) >> blockShift) - firstBlock + 1;
+		const size_t newSize = 2 * (usedBlocks + 1) > mapSize ? 2 * mapSize + 2 : mapSize;
+		const size_t newFirst = (newSize - usedBlocks) / 2;
+
+		T **tmp = (T **)std::malloc(newSize * sizeof(T *));
+		for (size_t i = 0; i < newSize; i++)
+			tmp[i] = nullptr;
+
+		for (size_t i = 0; i < usedBlocks; i++)
+		{
+			tmp[newFirst + i] = map[firstBlock + i];
+			map[firstBlock + i] = nullptr;
+		}
+
+		//blocks out of use are released together with the old map
+		for (size_t i = 0; i < mapSize; i++)
+			std::free(map[i]);
+		std::free(map);
+
+		map = tmp;
+		mapSize = newSize;
+		if (elemCnt == 0)
+			head = (newFirst << blockShift) + blockLen / 2;
+		else
+			head = (newFirst << blockShift) + (head & blockMask);
+	}
+
+	//make room for one more element before the first one, the slot becomes slot(0).
+	//The caller moves head back by one if it fails to construct the element there
+	void growFront()
+	{
+		if (head == 0)
+			reallocMap();
+
+		allocBlock((head - 1) >> blockShift);
+		--head;
+	}
+
+	//make room for one more element after the last one, the slot becomes slot(elemCnt)
+	void growBack()
+	{
+		if (head + elemCnt == mapSize * blockLen)
+			reallocMap();
+
+		allocBlock((head + elemCnt) >> blockShift);
+	}
+
+	//move the element in src to dst, dst should be raw memory
+	static void transfer(T *dst, T *src)
+	{
+		new (dst) T(std::move(*src));
+		src->~T();
+	}
+
+public:
+	class const_iterator;
+	class iterator
+	{
+		friend class const_iterator;
+		friend class fixed_block_deque<T>;
+
+	private:
+		fixed_block_deque<T> *ascription;
+		size_t index;
+
+	public:
+		iterator(fixed_block_deque<T> *_a = nullptr, size_t _i = 0) :
+			ascription(_a),
+			index(_i)
+		{}
+
+		iterator(const iterator &rhs) :
+			ascription(rhs.ascription),
+			index(rhs.index)
+		{}
+
+		// return the distance between two iterator,
+		// if these two iterators point to different deque, throw invaild_iterator.
+		int operator-(const iterator &rhs) const
+		{
+			if (ascription != rhs.ascription)
+				throw invalid_iterator();
+
+			return (int)index - (int)rhs.index;
+		}
+
+		iterator operator+(int n) const
+		{
+			iterator tmp(*this);
+			return tmp += n;
+		}
+
+		iterator operator-(int n) const
+		{
+			iterator tmp(*this);
+			return tmp -= n;
+		}
+
+		//moving beyond end() or before begin() is invalid
+		iterator& operator+=(int n)
+		{
+			if (n < 0)
+				return operator-=(-n);
+
+			if (index + n > ascription->elemCnt)
+				throw invalid_iterator();
+
+			index += n;
+			return *this;
+		}
+
+		iterator& operator-=(int n)
+		{
+			if (n < 0)
+				return operator+=(-n);
+
+			if ((size_t)n > index)
+				throw invalid_iterator();
+
+			index -= n;
+			return *this;
+		}
+
+		iterator operator++(int)
+		{
+			iterator tmp(*this);
+			++*this;
+			return tmp;
+		}
+
+		iterator& operator++()
+		{
+			return operator+=(1);
+		}
+
+		iterator operator--(int)
+		{
+			iterator tmp(*this);
+			--*this;
+			return tmp;
+		}
+
+		iterator& operator--()
+		{
+			return operator-=(1);
+		}
+
+		T& operator*() const
+		{
+			if (!ascription || index >= ascription->elemCnt)
+				throw invalid_iterator();
+
+			return *ascription->slot(index);
+		}
+
+		T* operator->() const
+		{
+			return &(operator*());
+		}
+
+		bool operator==(const iterator &rhs) const
+		{
+			return ascription && ascription == rhs.ascription && index == rhs.index;
+		}
+
+		bool operator==(const const_iterator &rhs) const
+		{
+			return ascription && ascription == rhs.ascription && index == rhs.index;
+		}
+
+		bool operator!=(const iterator &rhs) const
+		{
+			return !operator==(rhs);
+		}
+
+		bool operator!=(const const_iterator &rhs) const
+		{
+			return !operator==(rhs);
+		}
+
+		//check if the iterator is valid
+		bool isValid(void *id) const
+		{
+			return id && id == ascription && index <= ascription->elemCnt;
+		}
+	};
+
+	class const_iterator
+	{
+		friend class iterator;
+		friend class fixed_block_deque<T>;
+
+	private:
+		const fixed_block_deque<T> *ascription;
+		size_t index;
+
+	public:
+		const_iterator(const fixed_block_deque<T> *_a = nullptr, size_t _i = 0) :
+			ascription(_a),
+			index(_i)
+		{}
+
+		const_iterator(const iterator &rhs) :
+			ascription(rhs.ascription),
+			index(rhs.index)
+		{}
+
+		const_iterator(const const_iterator &rhs) :
+			ascription(rhs.ascription),
+			index(rhs.index)
+		{}
+
+		// return the distance between two iterator,
+		// if these two iterators point to different deque, throw invaild_iterator.
+		int operator-(const const_iterator &rhs) const
+		{
+			if (ascription != rhs.ascription)
+				throw invalid_iterator();
+
+			return (int)index - (int)rhs.index;
+		}
+
+		const_iterator operator+(int n) const
+		{
+			const_iterator tmp(*this);
+			return tmp += n;
+		}
+
+		const_iterator operator-(int n) const
+		{
+			const_iterator tmp(*this);
+			return tmp -= n;
+		}
+
+		//moving beyond end() or before begin() is invalid
+		const_iterator& operator+=(int n)
+		{
+			if (n < 0)
+				return operator-=(-n);
+
+			if (index + n > ascription->elemCnt)
+				throw invalid_iterator();
+
+			index += n;
+			return *this;
+		}
+
+		const_iterator& operator-=(int n)
+		{
+			if (n < 0)
+				return operator+=(-n);
+
+			if ((size_t)n > index)
+				throw invalid_iterator();
+
+			index -= n;
+			return *this;
+		}
+
+		const_iterator operator++(int)
+		{
+			const_iterator tmp(*this);
+			++*this;
+			return tmp;
+		}
+
+		const_iterator& operator++()
+		{
+			return operator+=(1);
+		}
+
+		const_iterator operator--(int)
+		{
+			const_iterator tmp(*this);
+			--*this;
+			return tmp;
+		}
+
+		const_iterator& operator--()
+		{
+			return operator-=(1);
+		}
+
+		const T& operator*() const
+		{
+			if (!ascription || index >= ascription->elemCnt)
+				throw invalid_iterator();
+
+			return *ascription->slot(index);
+		}
+
+		const T* operator->() const
+		{
+			return &(operator*());
+		}
+
+		bool operator==(const iterator &rhs) const
+		{
+			return ascription && ascription == rhs.ascription && index == rhs.index;
+		}
+
+		bool operator==(const const_iterator &rhs) const
+		{
+			return ascription && ascription == rhs.ascription && index == rhs.index;
+		}
+
+		bool operator!=(const iterator &rhs) const
+		{
+			return !operator==(rhs);
+		}
+
+		bool operator!=(const const_iterator &rhs) const
+		{
+			return !operator==(rhs);
+		}
+
+		//check if the iterator is valid
+		bool isValid(void *id) const
+		{
+			return id && id == ascription && index <= ascription->elemCnt;
+		}
+	};
+
+	fixed_block_deque() :
+		map(nullptr),
+		mapSize(0),
+		head(0),
+		elemCnt(0)
+	{}
+
+	fixed_block_deque(const fixed_block_deque &rhs) :
+		map(nullptr),
+		mapSize(0),
+		head(0),
+		elemCnt(0)
+	{
+		for (size_t i = 0; i < rhs.elemCnt; i++)
+			push_back(*rhs.slot(i));
+	}
+
+	~fixed_block_deque()
+	{
+		clear();
+		for (size_t i = 0; i < mapSize; i++)
+			std::free(map[i]);
+		std::free(map);
+	}
+
+	fixed_block_deque& operator=(fixed_block_deque other)
+	{
+		exchange(other);
+		return *this;
+	}
+
+	//access specified element with bounds checking
+	T& at(size_t pos)
+	{
+		if (pos >= elemCnt)
+			throw index_out_of_bound();
+
+		return *slot(pos);
+	}
+
+	const T& at(size_t pos) const
+	{
+		if (pos >= elemCnt)
+			throw index_out_of_bound();
+
+		return *slot(pos);
+	}
+
+	T& operator[](const size_t &pos)
+	{
+		return at(pos);
+	}
+
+	const T& operator[](const size_t &pos) const
+	{
+		return at(pos);
+	}
+
+	//access the first element
+	const T& front() const
+	{
+		if (empty())
+			throw container_is_empty();
+
+		return *slot(0);
+	}
+
+	//access the last element
+	const T& back() const
+	{
+		if (empty())
+			throw container_is_empty();
+
+		return *slot(elemCnt - 1);
+	}
+
+	iterator begin()
+	{
+		return iterator(this, 0);
+	}
+
+	const_iterator cbegin() const
+	{
+		return const_iterator(this, 0);
+	}
+
+	iterator end()
+	{
+		return iterator(this, elemCnt);
+	}
+
+	const_iterator cend() const
+	{
+		return const_iterator(this, elemCnt);
+	}
+
+	bool empty() const
+	{
+		return elemCnt == 0;
+	}
+
+	size_t size() const
+	{
+		return elemCnt;
+	}
+
+	//destroy all the elements, the blocks are kept for later use
+	void clear()
+	{
+		for (size_t i = 0; i < elemCnt; i++)
+			slot(i)->~T();
+
+		elemCnt = 0;
+		head = mapSize == 0 ? 0 : ((mapSize / 2) << blockShift) + blockLen / 2;
+	}
+
+	//inserts value before pos, elements on the shorter side are moved by one slot
+	iterator insert(iterator pos, const T &value)
+	{
+		if (!pos.isValid(this))
+			throw invalid_iterator();
+
+		const size_t idx = pos.index;
+		T copy(value);//value may lie in the slots to be moved, and a throwing copy leaves the deque untouched
+		if (idx < elemCnt / 2)
+		{
+			growFront();
+			for (size_t i = 0; i < idx; i++)
+				transfer(slot(i), slot(i + 1));
+		}
+		else
+		{
+			growBack();
+			for (size_t i = elemCnt; i > idx; i--)
+				transfer(slot(i), slot(i - 1));
+		}
+
+		new (slot(idx)) T(std::move(copy));
+		++elemCnt;
+		return iterator(this, idx);
+	}
+
+	//removes specified element at pos
+	iterator erase(iterator pos)
+	{
+		if (empty() || !pos.isValid(this) || pos == end())
+			throw invalid_iterator();
+
+		const size_t idx = pos.index;
+		slot(idx)->~T();
+
+		if (idx < elemCnt / 2)
+		{
+			for (size_t i = idx; i > 0; i--)
+				transfer(slot(i), slot(i - 1));
+			++head;
+		}
+		else
+		{
+			for (size_t i = idx; i + 1 < elemCnt; i++)
+				transfer(slot(i), slot(i + 1));
+		}
+
+		--elemCnt;
+		return iterator(this, idx);
+	}
+
+	void push_back(const T &value)
+	{
+		growBack();
+		new (slot(elemCnt)) T(value);
+		++elemCnt;
+	}
+
+	void pop_back()
+	{
+		if (empty())
+			throw container_is_empty();
+
+		--elemCnt;
+		slot(elemCnt)->~T();
+	}
+
+	void push_front(const T &value)
+	{
+		growFront();
+		try {
+			new (slot(0)) T(value);
+		} catch (...) {
+			++head;
+			throw;
+		}
+		++elemCnt;
+	}
+
+	void pop_front()
+	{
+		if (empty())
+			throw container_is_empty();
+
+		slot(0)->~T();
+		++head;
+		--elemCnt;
 	}
 };
 
@@ -7,6 +7,7 @@
 #include <cstdlib>
 #include <algorithm>
 #include <functional>
+#include <utility>
 
 namespace sjtu
 {
@@ -15,6 +16,8 @@ namespace sjtu
 	class list
 	{
 	private:
+		struct emplace_tag {};
+
 		class node
 		{
 			friend class list<T>;
@@ -28,6 +31,13 @@ namespace sjtu
 				prev = next = this;
 			}
 
+			//construct the data from args, the tag keeps it apart from the copy constructor
+			template<typename... Args>
+			node(emplace_tag, Args&&... args) :data(std::forward<Args>(args)...)
+			{
+				prev = next = this;
+			}
+
 			node(const node &rhs) :data(rhs.data)
 			{
 				prev = next = this;
@@ -354,6 +364,13 @@ namespace sjtu
 			}
 		}
 
+		//take over the elements of rhs, which is left empty
+		list(list &&rhs) :
+			list()
+		{
+			exchange(rhs);
+		}
+
 		//Destructor
 		~list()
 		{
@@ -378,6 +395,14 @@ namespace sjtu
 			return last->next->data;
 		}
 
+		T& front()
+		{
+			if (size() == 0)
+				throw container_is_empty();
+
+			return last->next->data;
+		}
+
 		//access the last element
 		//throw container_is_empty when it is empty
 		const T& back() const
@@ -388,6 +413,14 @@ namespace sjtu
 			return last->prev->data;
 		}
 
+		T& back()
+		{
+			if (size() == 0)
+				throw container_is_empty();
+
+			return last->prev->data;
+		}
+
 		//returns an iterator to the beginning
 		iterator begin()
 		{
@@ -453,6 +486,21 @@ namespace sjtu
 			return iterator(this, p);
 		}
 
+		//constructs a new element from args before pos
+		//returns an iterator pointing to the new element
+		template<typename... Args>
+		iterator emplace(iterator pos, Args&&... args)
+		{
+			if (pos.ascription != this)
+				throw invalid_iterator();
+
+			node *p = new node(emplace_tag(), std::forward<Args>(args)...);
+			node::insert_before(p, pos.cur);
+			++elemCnt;
+
+			return iterator(this, p);
+		}
+
 		//removes the element at pos.
 		//returns an iterator following the last removed element.
 		//If there was anything wrong with the iterator, throw invalid_iterator.
@@ -509,6 +557,17 @@ namespace sjtu
 			insert(end(), value);
 		}
 
+		void push_back(T &&value)
+		{
+			emplace(end(), std::move(value));
+		}
+
+		template<typename... Args>
+		void emplace_back(Args&&... args)
+		{
+			emplace(end(), std::forward<Args>(args)...);
+		}
+
 		//removes the last element
 		void pop_back()
 		{
@@ -521,6 +580,17 @@ namespace sjtu
 			insert(begin(), value);
 		}
 
+		void push_front(T &&value)
+		{
+			emplace(begin(), std::move(value));
+		}
+
+		template<typename... Args>
+		void emplace_front(Args&&... args)
+		{
+			emplace(begin(), std::forward<Args>(args)...);
+		}
+
 		//removes the first element
 		void pop_front()
 		{
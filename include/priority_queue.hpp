@@ -2,12 +2,18 @@
 #define SJTU_PRIORITY_QUEUE_HPP
 
 #include <algorithm>
+#include <cstdio>
 #include <cstdlib>
 #include <cstddef>
 #include <functional>
+#include <limits>
+#include <new>
+#include <type_traits>
+#include <utility>
 
 #include "exceptions.hpp"
 #include "vector.hpp"
+#include "algorithm.hpp"
 
 namespace sjtu 
 {
@@ -45,6 +51,27 @@ private:
 		}
 	}
 
+	//Restore the heap after m elements were appended to the back.
+	//A few elements are percolated up one by one, otherwise the whole heap is rebuilt by sjtu::make_heap in O(n).
+	void fixAppended(size_t m)
+	{
+		if (m == 0)
+			return;
+
+		const size_t total = c.size();
+		size_t logTotal = 0;
+		while ((size_t)1 << logTotal < total)
+			++logTotal;
+
+		if (m * logTotal < total)
+		{
+			for (size_t i = total - m; i < total; i++)
+				percolateUp(i);
+		}
+		else//make_heap puts the least under its comparison on the top
+			sjtu::make_heap(c.begin(), c.end(), [this](const T &a, const T &b) { return cmp(b, a); });
+	}
+
 	void percolateUp(size_t pos)
 	{
 		size_t father = 0;
@@ -96,10 +123,493 @@ public:
 		percolateDown(0);
 
 	}
+
+	//Append [first, last) to the vector, then percolate the new elements up or call make_heap, whichever is cheaper.
+	template<class InputIterator>
+	void push_range(InputIterator first, InputIterator last)
+	{
+		size_t m = 0;
+		for (; first != last; ++first, ++m)
+			c.push_back(*first);
+		fixAppended(m);
+	}
+
+	//Move the elements of rhs to the back and fix them as push_range does. rhs is left empty.
+	void merge(binary_heap &rhs)
+	{
+		if (&rhs == this || rhs.empty())
+			return;
+
+		const size_t m = rhs.size();
+		for (size_t i = 0; i < m; i++)
+			c.push_back(std::move(rhs.c[i]));
+		rhs.c.clear();
+		fixAppended(m);
+	}
+};
+
+//A d-ary heap for the internal heap of a priority_queue, 4-ary by default.
+//The elements live in a buffer of its own instead of a vector, so the indexing is unchecked,
+//and the buffer is shifted by one slot so that the D children of a node share one cache line
+//whenever D*sizeof(T) divides the line. Percolation moves a hole instead of swapping at every level.
+template<typename T, class Compare = std::less<T>, size_t D = 4>
+class dary_heap
+{
+	static_assert(D >= 2, "a d-ary heap needs at least two children for each node");
+
+private:
+	static const size_t cache_line = 64;
+
+	char *block;//what malloc returns
+	T *c;//c[0] is the top, the children of c[i] are c[D*i+1] ... c[D*i+D]
+	size_t n, cap;
+	Compare cmp;
+
+	static size_t parent(size_t i) { return (i - 1) / D; }
+	static size_t first_child(size_t i) { return D * i + 1; }
+
+	//allocate room for _cap elements, with c+1 on a cache line boundary
+	void allocate(size_t _cap)
+	{
+		char *p = (char*)std::malloc(_cap * sizeof(T) + cache_line + sizeof(T));
+		if (!p)
+			throw std::bad_alloc();
+		block = p;
+		size_t aligned = ((size_t)p + sizeof(T) + cache_line - 1) / cache_line * cache_line;
+		c = (T*)(aligned - sizeof(T));
+		cap = _cap;
+	}
+
+	void release()
+	{
+		for (size_t i = 0; i < n; i++)
+			c[i].~T();
+		std::free(block);
+	}
+
+	void doubleSpace()
+	{
+		char *oldBlock = block;
+		T *old = c;
+		allocate(cap ? cap * 2 : 16);
+		for (size_t i = 0; i < n; i++)
+		{
+			new (c + i) T(std::move(old[i]));
+			old[i].~T();
+		}
+		std::free(oldBlock);
+	}
+
+	//move the element at pos up to its place
+	void percolateUp(size_t pos)
+	{
+		T tmp(std::move(c[pos]));
+		while (pos > 0)
+		{
+			size_t father = parent(pos);
+			if (!cmp(c[father], tmp))
+				break;
+			c[pos] = std::move(c[father]);
+			pos = father;
+		}
+		c[pos] = std::move(tmp);
+	}
+
+	//restore the heap after the last m of the n elements were appended: percolate them up if m*log(n) < n,
+	//otherwise move every inner node down through its hole, from the parent of the last element to the root
+	void fixAppended(size_t m)
+	{
+		if (m == 0)
+			return;
+
+		size_t logTotal = 0;
+		while ((size_t)1 << logTotal < n)
+			++logTotal;
+
+		if (m * logTotal < n)
+		{
+			for (size_t i = n - m; i < n; i++)
+				percolateUp(i);
+		}
+		else
+		{
+			for (size_t i = parent(n - 1) + 1; i > 0; i--)
+			{
+				T tmp(std::move(c[i - 1]));
+				percolateDown(i - 1, tmp);
+			}
+		}
+	}
+
+	//put tmp into the hole at pos and move it down to its place
+	void percolateDown(size_t pos, T &tmp)
+	{
+		size_t child;
+		while ((child = first_child(pos)) < n)
+		{
+			size_t best = child;
+			if (child + D <= n)
+			{
+				//a full group, with a constant trip count the compiler can unroll
+				for (size_t k = 1; k < D; k++)
+					if (cmp(c[best], c[child + k]))
+						best = child + k;
+			}
+			else
+			{
+				for (++child; child < n; ++child)
+					if (cmp(c[best], c[child]))
+						best = child;
+			}
+
+			if (!cmp(tmp, c[best]))
+				break;
+			c[pos] = std::move(c[best]);
+			pos = best;
+		}
+		c[pos] = std::move(tmp);
+	}
+
+	void exchange(dary_heap &rhs)
+	{
+		using std::swap;
+		swap(block, rhs.block);
+		swap(c, rhs.c);
+		swap(n, rhs.n);
+		swap(cap, rhs.cap);
+		swap(cmp, rhs.cmp);
+	}
+
+public:
+	dary_heap() :block(nullptr), c(nullptr), n(0), cap(0) {}
+	dary_heap(const Compare &x) :block(nullptr), c(nullptr), n(0), cap(0), cmp(x) {}
+
+	dary_heap(const dary_heap &other) :block(nullptr), c(nullptr), n(0), cap(0), cmp(other.cmp)
+	{
+		if (other.n > 0)
+		{
+			allocate(other.n);
+			for (; n < other.n; n++)
+				new (c + n) T(other.c[n]);
+		}
+	}
+
+	~dary_heap() { release(); }
+
+	dary_heap &operator=(dary_heap rhs)
+	{
+		exchange(rhs);
+		return *this;
+	}
+
+	bool empty() const { return n == 0; }
+
+	size_t size() const { return n; }
+
+	const T &front() const
+	{
+		if (n == 0)
+			throw container_is_empty();
+
+		return c[0];
+	}
+
+	void push_back(const T &elem)
+	{
+		if (n == cap)
+		{
+			T tmp(elem);//elem may live in this heap
+			doubleSpace();
+			new (c + n) T(std::move(tmp));
+		}
+		else
+			new (c + n) T(elem);
+		percolateUp(n++);
+	}
+
+	void pop_front()
+	{
+		--n;
+		if (n > 0)
+		{
+			T tmp(std::move(c[n]));
+			c[n].~T();
+			percolateDown(0, tmp);
+		}
+		else
+			c[0].~T();
+	}
+
+	//Append [first, last) to the buffer, which doubles as needed, then fix the heap once by fixAppended.
+	template<class InputIterator>
+	void push_range(InputIterator first, InputIterator last)
+	{
+		size_t m = 0;
+		for (; first != last; ++first, ++m)
+		{
+			if (n == cap)
+				doubleSpace();
+			new (c + n) T(*first);
+			++n;
+		}
+		fixAppended(m);
+	}
+
+	//Grow the buffer for both heaps first, then move the elements of rhs after ours and fix them as push_range does.
+	//rhs is left empty.
+	void merge(dary_heap &rhs)
+	{
+		if (&rhs == this || rhs.empty())
+			return;
+
+		const size_t m = rhs.n;
+		while (cap < n + m)
+			doubleSpace();
+		for (size_t i = 0; i < m; i++)
+		{
+			new (c + n + i) T(std::move(rhs.c[i]));
+			rhs.c[i].~T();
+		}
+		rhs.n = 0;
+		n += m;
+		fixAppended(m);
+	}
+};
+
+//A min-max heap on a vector, where both the least and the greatest element are at hand.
+//The levels of the tree alternate: an element on an even level (the root is on level 0) is the least of its subtree,
+//and an element on an odd level is the greatest of its subtree. So min() is the root and max() one of its children,
+//and pop_min and pop_max both take O(log(n)), moving an element down two levels at a time.
+//front and pop_front are max() and pop_max(), so it also serves as the internal heap of a priority_queue.
+template<typename T, class Compare = std::less<T> >
+class minmax_heap
+{
+private:
+	sjtu::vector<T> c;
+	Compare cmp;
+
+	static size_t parent(size_t i) { return (i - 1) / 2; }
+	static size_t left(size_t i) { return 2 * i + 1; }
+
+	static bool onMaxLevel(size_t i)
+	{
+		size_t depth = 0;
+		for (++i; i > 1; i >>= 1)
+			++depth;
+		return depth % 2 == 1;
+	}
+
+	//whether a should be nearer to the top of a min (isMax = false) or a max (isMax = true) level than b
+	template<bool isMax>
+	bool before(const T &a, const T &b) const { return isMax ? cmp(b, a) : cmp(a, b); }
+
+	//move the element at pos up along the levels of the same kind
+	template<bool isMax>
+	void percolateUp(size_t pos)
+	{
+		while (pos > 2)
+		{
+			size_t grand = parent(parent(pos));
+			if (!before<isMax>(c[pos], c[grand]))
+				break;
+			std::swap(c[pos], c[grand]);
+			pos = grand;
+		}
+	}
+
+	//place the element at pos, which may be on the wrong kind of level for its parent
+	void percolateUp(size_t pos)
+	{
+		if (pos == 0)
+			return;
+
+		size_t father = parent(pos);
+		if (onMaxLevel(pos))
+		{
+			if (cmp(c[pos], c[father]))
+			{
+				std::swap(c[pos], c[father]);
+				percolateUp<false>(father);
+			}
+			else
+				percolateUp<true>(pos);
+		}
+		else
+		{
+			if (cmp(c[father], c[pos]))
+			{
+				std::swap(c[pos], c[father]);
+				percolateUp<true>(father);
+			}
+			else
+				percolateUp<false>(pos);
+		}
+	}
+
+	//move the element at pos down as a hole: the best of its children and grandchildren moves up,
+	//and when that was a grandchild, the element is swapped with the child in between if it belongs there
+	template<bool isMax>
+	void percolateDown(size_t pos)
+	{
+		const size_t n = c.size();
+		T tmp(std::move(c[pos]));
+		size_t child;
+		while ((child = left(pos)) < n)
+		{
+			size_t best = child;
+			if (child + 1 < n && before<isMax>(c[child + 1], c[best]))
+				best = child + 1;
+			for (size_t g = left(child); g < n && g < left(child) + 4; g++)
+				if (before<isMax>(c[g], c[best]))
+					best = g;
+
+			if (!before<isMax>(c[best], tmp))
+				break;
+			c[pos] = std::move(c[best]);
+			pos = best;
+			if (best <= child + 1)
+				break;
+
+			size_t father = parent(best);
+			if (before<isMax>(c[father], tmp))
+				std::swap(c[father], tmp);
+		}
+		c[pos] = std::move(tmp);
+	}
+
+	void percolateDown(size_t pos)
+	{
+		if (onMaxLevel(pos))
+			percolateDown<true>(pos);
+		else
+			percolateDown<false>(pos);
+	}
+
+	size_t maxIndex() const
+	{
+		if (c.size() < 3)
+			return c.size() - 1;
+		return cmp(c[1], c[2]) ? 2 : 1;
+	}
+
+	//restore the heap after m elements were appended to the back. A few are moved up one by one,
+	//otherwise each node with a child is trickled down on its own kind of level, the deepest first, in O(n).
+	void fixAppended(size_t m)
+	{
+		if (m == 0)
+			return;
+
+		const size_t total = c.size();
+		size_t logTotal = 0;
+		while ((size_t)1 << logTotal < total)
+			++logTotal;
+
+		if (m * logTotal < total)
+		{
+			for (size_t i = total - m; i < total; i++)
+				percolateUp(i);
+		}
+		else
+		{
+			for (size_t i = total / 2; i > 0; i--)
+				percolateDown(i - 1);
+		}
+	}
+
+public:
+	minmax_heap() {}
+	minmax_heap(const Compare &x) :cmp(x) {}
+
+	minmax_heap(const minmax_heap &other) :c(other.c), cmp(other.cmp) {}
+
+	bool empty() const { return c.empty(); }
+
+	size_t size() const { return c.size(); }
+
+	//the least element, throw container_is_empty if empty.
+	const T &min() const
+	{
+		if (c.empty())
+			throw container_is_empty();
+
+		return c[0];
+	}
+
+	//the greatest element, throw container_is_empty if empty.
+	const T &max() const
+	{
+		if (c.empty())
+			throw container_is_empty();
+
+		return c[maxIndex()];
+	}
+
+	void push(const T &elem)
+	{
+		c.push_back(elem);
+		percolateUp(c.size() - 1);
+	}
+
+	//remove the least element, throw container_is_empty if empty.
+	void pop_min()
+	{
+		if (c.empty())
+			throw container_is_empty();
+
+		if (c.size() > 1)
+			c[0] = std::move(c.back());
+		c.pop_back();
+		if (!c.empty())
+			percolateDown<false>(0);
+	}
+
+	//remove the greatest element, throw container_is_empty if empty.
+	void pop_max()
+	{
+		if (c.empty())
+			throw container_is_empty();
+
+		size_t pos = maxIndex();
+		if (pos + 1 < c.size())
+			c[pos] = std::move(c.back());
+		c.pop_back();
+		if (pos < c.size())
+			percolateDown<true>(pos);
+	}
+
+	//Append [first, last), then move the new elements up by their grandparents, or rebuild bottom-up when that is cheaper.
+	template<class InputIterator>
+	void push_range(InputIterator first, InputIterator last)
+	{
+		size_t m = 0;
+		for (; first != last; ++first, ++m)
+			c.push_back(*first);
+		fixAppended(m);
+	}
+
+	//Take over the elements of rhs and fix them as push_range does. rhs is left empty.
+	void merge(minmax_heap &rhs)
+	{
+		if (&rhs == this || rhs.empty())
+			return;
+
+		const size_t m = rhs.size();
+		for (size_t i = 0; i < m; i++)
+			c.push_back(std::move(rhs.c[i]));
+		rhs.c.clear();
+		fixAppended(m);
+	}
+
+	//the interface of the internal heap of a priority_queue, whose top is the greatest
+	const T &front() const { return max(); }
+	void push_back(const T &elem) { push(elem); }
+	void pop_front() { pop_max(); }
 };
 
 //A fibonacci heap for the internal heap of a priority_queue.
 //Obviously, this data structure differs from binary heap as it supports the merge operation.
+//push_back returns a handle of the new element, with which the key can be raised towards the top
+//by decrease_key in O(1) amortised time, or the element removed by erase in O(log(n)) amortised time.
 template<typename T, class Compare = std::less<T> >
 class fibonacci_heap
 {
@@ -204,15 +714,16 @@ private:
 			return z;
 		}
 
-		//ǰ
-		fibonacci_node* copy() const
+		//ǰڵpool
+		template<class Pool>
+		fibonacci_node* copy(Pool &pool) const
 		{
-			fibonacci_node* z = new fibonacci_node(*this);
+			fibonacci_node* z = pool.make(*this);
 			if (child)
 			{
 				auto w = child;
 				do {
-					auto cur_child_copy = w->copy();
+					auto cur_child_copy = w->copy(pool);
 					cur_child_copy->parent = z;
 
 					if (z->child == nullptr)
@@ -226,15 +737,16 @@ private:
 			return z;
 		}
 
-		//ͷŵǰ
-		void release()
+		//ͷŵǰڵ黹pool
+		template<class Pool>
+		void release(Pool &pool)
 		{
 			while (child)
 			{
 				auto z = remove_single(child);
-				z->release();
+				z->release(pool);
 			}
-			delete this;//ҪԼɾԼ
+			pool.destroy(this);//ҪԼɾԼ
 		}
 
 		//_y_xĺб
@@ -246,54 +758,221 @@ private:
 				_x.child = &_y;
 
 			++_x.degree;
+			_y.parent = &_x;
 			_y.flag = false;
 		}
 	};
 
-private:
-	size_t n;
-	fibonacci_node<T> *root;
-	Compare *cmp;
-
-	//operator=ĸ
-	void exchange(fibonacci_heap &rhs)
+	//ڵأ(slab)ڵĴ洢ͷŵĽڵԱ㸴
+	//ڶʱŹ黹ȶ״̬pushpopٵnewdelete
+	class node_pool
 	{
-		using std::swap;
-		swap(n, rhs.n);
-		swap(root, rhs.root);
-		swap(cmp, rhs.cmp);
-	}
+	private:
+		typedef fibonacci_node<T> node;
 
-	//һfibonacci_heapǰ
-	//Copy constructorĸ
-	void duplicate(const fibonacci_heap &rhs)
-	{
-		auto w = rhs.root;
-		do {
-			auto z = w->copy();//ýڵͬ
-			insert(*z);
-			w = w->right;
-		} while (w != rhs.root);
-	}
+		struct slab { slab *next; };
+		struct free_cell { free_cell *next; };//нڵĴ洢Ϊָ
 
-	//ͷŵǰfibonacci_heapенڵ
-	//Destructorĸ
-	void destroy()
-	{
-		while (root)//ÿremove_singlerootָԶı
+		static const size_t header = (sizeof(slab) + alignof(node) - 1) / alignof(node) * alignof(node);
+		static const size_t max_slab_cells = 1024;
+
+		slab *slabs, *lastSlab;
+		free_cell *freeHead, *freeTail;
+		char *bump, *bumpEnd;//µĿδùĲ
+		size_t slabCells;//һĽڵmax_slab_cells
+
+		void grow()
+		{
+			slab *z = (slab*)std::malloc(header + slabCells * sizeof(node));
+			if (!z)
+				throw std::bad_alloc();
+
+			z->next = slabs;
+			if (!slabs)
+				lastSlab = z;
+			slabs = z;
+			bump = (char*)z + header;
+			bumpEnd = bump + slabCells * sizeof(node);
+			if (slabCells < max_slab_cells)
+				slabCells *= 2;
+		}
+
+		void* take()
+		{
+			if (freeHead)
+			{
+				void *p = freeHead;
+				freeHead = freeHead->next;
+				if (!freeHead)
+					freeTail = nullptr;
+				return p;
+			}
+
+			if (bump == bumpEnd)
+				grow();
+			void *p = bump;
+			bump += sizeof(node);
+			return p;
+		}
+
+		void give(void *p)
+		{
+			free_cell *z = (free_cell*)p;
+			z->next = freeHead;
+			if (!freeHead)
+				freeTail = z;
+			freeHead = z;
+		}
+
+	public:
+		node_pool() :slabs(nullptr), lastSlab(nullptr), freeHead(nullptr), freeTail(nullptr),
+			bump(nullptr), bumpEnd(nullptr), slabCells(16) {}
+
+		node_pool(const node_pool &) = delete;
+		node_pool& operator=(const node_pool &) = delete;
+
+		//нڵ㶼ӦѾdestroy
+		~node_pool()
+		{
+			while (slabs)
+			{
+				slab *z = slabs;
+				slabs = slabs->next;
+				std::free(z);
+			}
+		}
+
+		template<typename... Args>
+		node* make(Args&&... args)
+		{
+			void *p = take();
+			try {
+				return new (p) node(std::forward<Args>(args)...);
+			} catch (...) {
+				give(p);
+				throw;
+			}
+		}
+
+		void destroy(node *p)
+		{
+			p->~node();
+			give(p);
+		}
+
+		//O(1)ڽӹrhsȫ洢rhsеĽڵ˺ɱػ
+		//δùĲֻϴһΣһֱǰʹ
+		void splice(node_pool &rhs)
+		{
+			if (rhs.slabs)
+			{
+				rhs.lastSlab->next = slabs;
+				if (!slabs)
+					lastSlab = rhs.lastSlab;
+				slabs = rhs.slabs;
+			}
+			if (rhs.freeHead)
+			{
+				rhs.freeTail->next = freeHead;
+				if (!freeHead)
+					freeTail = rhs.freeTail;
+				freeHead = rhs.freeHead;
+			}
+			if (rhs.bumpEnd - rhs.bump > bumpEnd - bump)
+			{
+				bump = rhs.bump;
+				bumpEnd = rhs.bumpEnd;
+			}
+
+			rhs.slabs = rhs.lastSlab = nullptr;
+			rhs.freeHead = rhs.freeTail = nullptr;
+			rhs.bump = rhs.bumpEnd = nullptr;
+		}
+
+		void exchange(node_pool &rhs)
+		{
+			using std::swap;
+			swap(slabs, rhs.slabs);
+			swap(lastSlab, rhs.lastSlab);
+			swap(freeHead, rhs.freeHead);
+			swap(freeTail, rhs.freeTail);
+			swap(bump, rhs.bump);
+			swap(bumpEnd, rhs.bumpEnd);
+			swap(slabCells, rhs.slabCells);
+		}
+	};
+
+	//Ͻ磺D(n) <= log(n)/log(phi)1/log2(phi)ԼΪ1.44 < 1.5size_tܱʾnᳬ
+	static const size_t max_degree = sizeof(size_t) * 8 * 3 / 2;
+
+private:
+	size_t n;
+	fibonacci_node<T> *root;
+	Compare *cmp;
+	node_pool pool;
+	fibonacci_node<T> *degreeTable[max_degree];//consolidateõĶȫûnullptr
+
+	//operator=ĸ
+	void exchange(fibonacci_heap &rhs)
+	{
+		using std::swap;
+		swap(n, rhs.n);
+		swap(root, rhs.root);
+		swap(cmp, rhs.cmp);
+		pool.exchange(rhs.pool);
+	}
+
+	//һfibonacci_heapǰ
+	//Copy constructorĸ
+	void duplicate(const fibonacci_heap &rhs)
+	{
+		if (!rhs.root)
+			return;
+
+		auto w = rhs.root;
+		do {
+			auto z = w->copy(pool);//ýڵͬ
+			insert(*z);
+			w = w->right;
+		} while (w != rhs.root);
+	}
+
+	//ͷŵǰfibonacci_heapенڵ
+	//Destructorĸ
+	void destroy()
+	{
+		while (root)//ÿremove_singlerootָԶı
 		{
 			auto z = fibonacci_node<T>::remove_single(root);
-			z->release();
+			z->release(pool);
 		}
 		n = 0;
 	}
 
 public:
+	//refers to an element in the heap, valid until the element is popped or erased.
+	//A copy of the heap has nodes of its own, so the handles are not shared.
+	class handle
+	{
+		friend class fibonacci_heap;
+
+	private:
+		fibonacci_node<T> *node;
+
+		handle(fibonacci_node<T> *p) :node(p) {}
+
+	public:
+		handle() :node(nullptr) {}
+
+		bool operator==(const handle &rhs) const { return node == rhs.node; }
+		bool operator!=(const handle &rhs) const { return node != rhs.node; }
+	};
+
 	//Default constructor
-	fibonacci_heap() :n(0), root(nullptr), cmp(new Compare()) {}
+	fibonacci_heap() :n(0), root(nullptr), cmp(new Compare()), degreeTable() {}
 
 	//Copy constructor 
-	fibonacci_heap(const fibonacci_heap &rhs) :n(rhs.n), root(nullptr), cmp(new Compare(*rhs.cmp))
+	fibonacci_heap(const fibonacci_heap &rhs) :n(rhs.n), root(nullptr), cmp(new Compare(*rhs.cmp)), degreeTable()
 	{
 		duplicate(rhs); 
 	}
@@ -331,21 +1010,165 @@ public:
 	}
 
 	//Push a new fibonacci_node into current heap with given key.
-	void push_back(const T &_key) 
+	//Return the handle of the new element.
+	handle push_back(const T &_key) 
 	{ 
-		auto tmp = new fibonacci_node<T>(_key);
+		auto tmp = pool.make(_key);
 		insert(*tmp);
 		n++;
+		return handle(tmp);
+	}
+
+	//Push all the elements of [first, last): the new nodes are linked into a list of their own,
+	//which is spliced into the root list at once together with the best of them.
+	template<class InputIterator>
+	void push_range(InputIterator first, InputIterator last)
+	{
+		fibonacci_node<T> *list = nullptr, *best = nullptr;
+		size_t m = 0;
+		try {
+			for (; first != last; ++first, ++m)
+			{
+				auto z = pool.make(*first);
+				if (!list)
+					list = best = z;
+				else
+				{
+					fibonacci_node<T>::insert_before(*list, *z);
+					if ((*cmp)(best->key, z->key))
+						best = z;
+				}
+			}
+		} catch (...) {
+			spliceRoots(list, best, m);//keep the elements pushed so far
+			throw;
+		}
+		spliceRoots(list, best, m);
+	}
+
+	//Get the key of the element referred to by h.
+	const T& get(const handle &h) const
+	{
+		if (!h.node)
+			throw invalid_iterator();
+
+		return h.node->key;
+	}
+
+	//Replace the key of the element referred to by h with _key, which must not be worse than the old one,
+	//i.e. the element can only move towards the top. Throw runtime_error otherwise.
+	//If the new key beats the parent, the node is cut into the root list, and so are the marked ancestors.
+	void decrease_key(const handle &h, const T &_key)
+	{
+		auto x = h.node;
+		if (!x)
+			throw invalid_iterator();
+		if ((*cmp)(_key, x->key))
+			throw runtime_error();
+
+		x->key = _key;
+		auto y = x->parent;
+		if (y && (*cmp)(y->key, x->key))
+		{
+			cut(x);
+			cascading_cut(y);
+		}
+
+		if ((*cmp)(root->key, x->key))
+			root = x;
+	}
+
+	//Splice the root list of rhs into this heap in O(1) and leave rhs empty.
+	//The handles of rhs stay valid and now refer to elements of this heap.
+	void merge(fibonacci_heap &rhs)
+	{
+		if (&rhs == this || !rhs.root)
+			return;
+
+		spliceRoots(rhs.root, rhs.root, rhs.n);
+		rhs.root = nullptr;
+		rhs.n = 0;
+		pool.splice(rhs.pool);
+	}
+
+	//Remove the element referred to by h, which is cut into the root list and extracted as if it were the top.
+	void erase(const handle &h)
+	{
+		auto x = h.node;
+		if (!x)
+			throw invalid_iterator();
+
+		auto y = x->parent;
+		if (y)
+		{
+			cut(x);
+			cascading_cut(y);
+		}
+
+		root = x;
+		pool.destroy(extract_root());
 	}
 
 	//Pop root node and release it.
 	void pop_front()
 	{ 
 		auto tmp= extract_root();
-		delete tmp;
+		pool.destroy(tmp);
 	}
 
 private:
+	//һmڵĸlistbestΪйؼ
+	void spliceRoots(fibonacci_node<T> *list, fibonacci_node<T> *best, size_t m)
+	{
+		if (!list)
+			return;
+
+		if (!root)
+			root = best;
+		else
+		{
+			fibonacci_node<T>::insert_before(*root, *list);
+			if ((*cmp)(root->key, best->key))
+				root = best;
+		}
+		n += m;
+	}
+
+	//x丸׵ĺбȡ
+	void cut(fibonacci_node<T> *x)
+	{
+		auto y = x->parent;
+		if (y->child == x)
+			fibonacci_node<T>::remove_single(y->child);
+		else
+		{
+			auto t = x;//remove_single޸Ĵָ
+			fibonacci_node<T>::remove_single(t);
+		}
+
+		--y->degree;
+		x->parent = nullptr;
+		x->flag = false;
+		fibonacci_node<T>::insert_before(*root, *x);
+	}
+
+	//yʧȥһӣyѱǹyҲ²ϣy
+	void cascading_cut(fibonacci_node<T> *y)
+	{
+		while (y->parent)
+		{
+			if (!y->flag)
+			{
+				y->flag = true;
+				return;
+			}
+
+			auto z = y->parent;
+			cut(y);
+			y = z;
+		}
+	}
+
 	//ڸвһڵ,ͬ
 	void insert(fibonacci_node<T> &x)
 	{
@@ -396,9 +1219,8 @@ private:
 	//ϲɺroot
 	void consolidate()
 	{
-		double phi = 0.5*(1.0 + std::sqrt(5));//ƽָ
-		size_t num = std::ceil(std::log2(1.0*n) / std::log2(phi)) + 1;//D(n)<=floor(log2(n)/log2(phi))
-		auto A = vector<fibonacci_node<T>*>(num, nullptr);
+		auto A = degreeTable;
+		size_t num = 0;//AõĶСnum
 
 		//ȡеĽڵ㣬ϲͬdegreeĽڵ㵽A
 		while (root)
@@ -416,10 +1238,12 @@ private:
 				++d;
 			}
 			A[d] = x;
+			if (d >= num)
+				num = d + 1;
 		}
 
-		//ع
-		for (auto i = 0; i < A.size(); i++)
+		//عAûnullptr
+		for (size_t i = 0; i < num; i++)
 		{
 			if (A[i])
 			{
@@ -431,82 +1255,1254 @@ private:
 					if ((*cmp)(root->key, A[i]->key))
 						root = A[i];
 				}
+				A[i] = nullptr;
 			}
 		}
 	}
 };
 
-//A container like std::priority_queue which is a heap internal.
-template<typename T, class Compare = std::less<T>, typename HeapTypeDef = fibonacci_heap<T, Compare> >
-class priority_queue
+//A pairing heap for the internal heap of a priority_queue.
+//A node keeps only its key and three pointers: the first child, the next sibling, and prev,
+//which is the previous sibling, or the parent for a first child.
+//push_back and merge meld two trees in O(1), pop_front combines the children of the top by two-pass pairing
+//in O(log(n)) amortised time, and decrease_key cuts the element out and melds it with the top.
+template<typename T, class Compare = std::less<T> >
+class pairing_heap
 {
 private:
-	HeapTypeDef *heap;
+	struct pairing_node
+	{
+		T key;
+		pairing_node *child, *next, *prev;
 
-	void swap(priority_queue &other) { std::swap(heap, other.heap); }
+		pairing_node(const T &_key) :key(_key), child(nullptr), next(nullptr), prev(nullptr) {}
+	};
 
-public:
-	/**
-	* constructors
-	*/
-	priority_queue() :heap(new HeapTypeDef()) {}
-	priority_queue(const priority_queue &other) :heap(new HeapTypeDef(*(other.heap))) {}
+	size_t n;
+	pairing_node *root;
+	Compare cmp;
 
-	/**
-	* deconstructor
-	*/
-	~priority_queue() { delete heap; }
+	//Link the worse of the two roots as the first child of the other one, and return the new root.
+	pairing_node* meld(pairing_node *a, pairing_node *b)
+	{
+		if (cmp(a->key, b->key))
+			std::swap(a, b);
+
+		b->next = a->child;
+		if (a->child)
+			a->child->prev = b;
+		b->prev = a;
+		a->child = b;
+		return a;
+	}
 
-	/**
-	* Assignment operator
-	*/
-	priority_queue &operator=(const priority_queue &other)
+	//Combine a list of siblings into one tree: meld them in pairs from left to right,
+	//then meld the pairs into one from right to left. The pairs are kept in a list through next, the last one first.
+	pairing_node* combine(pairing_node *first)
 	{
-		priority_queue tmp(other);
-		swap(tmp);
-		return *this;
+		pairing_node *pairs = nullptr;
+		while (first)
+		{
+			pairing_node *a = first, *b = first->next;
+			a->prev = a->next = nullptr;
+			if (b)
+			{
+				first = b->next;
+				b->prev = b->next = nullptr;
+				a = meld(a, b);
+			}
+			else
+				first = nullptr;
+			a->next = pairs;
+			pairs = a;
+		}
+
+		pairing_node *r = pairs;
+		if (r)
+		{
+			pairs = r->next;
+			r->next = nullptr;
+			while (pairs)
+			{
+				pairing_node *a = pairs;
+				pairs = a->next;
+				a->next = nullptr;
+				r = meld(r, a);
+			}
+		}
+		return r;
 	}
 
-	/**
-	* get the top of the queue.
-	* @return a reference of the top element.
-	* throw container_is_empty if empty() returns true;
-	*/
-	const T & top() const
+	//Make best the parent of the other m-1 new nodes in list, and meld it with the top.
+	void meldList(pairing_node *list, pairing_node *best, size_t m)
 	{
-		if (empty())
-			throw container_is_empty();
+		if (!list)
+			return;
 
-		return heap->front();
+		if (best == list)
+			list = best->next;
+		else
+			best->prev->next = best->next;
+		if (best->next)
+			best->next->prev = best->prev;
+		best->prev = best->next = nullptr;
+
+		if (list)
+		{
+			list->prev = best;
+			best->child = list;
+		}
+		root = root ? meld(root, best) : best;
+		n += m;
 	}
 
-	/**
-	* push new element to the priority queue.
-	*/
-	void push(const T &e) { heap->push_back(e); }
+	//Take x with its subtree out of the list of its siblings.
+	static void detach(pairing_node *x)
+	{
+		if (x->prev->child == x)
+			x->prev->child = x->next;
+		else
+			x->prev->next = x->next;
+		if (x->next)
+			x->next->prev = x->prev;
+		x->prev = x->next = nullptr;
+	}
 
-	/**
-	* delete the top element.
-	* throw container_is_empty if empty() returns true;
-	*/
-	void pop()
+	//Deep copy of rhs, with an explicit stack since a pairing heap can be as deep as it is large.
+	void duplicate(const pairing_heap &rhs)
 	{
-		if (empty())
-			throw container_is_empty();
+		if (!rhs.root)
+			return;
 
-		heap->pop_front();
+		root = new pairing_node(rhs.root->key);
+		vector<std::pair<const pairing_node*, pairing_node*> > todo;
+		todo.push_back(std::make_pair(rhs.root, root));
+		while (!todo.empty())
+		{
+			const pairing_node *from = todo.back().first;
+			pairing_node *to = todo.back().second;
+			todo.pop_back();
+
+			pairing_node *last = nullptr;
+			for (const pairing_node *c = from->child; c; c = c->next)
+			{
+				pairing_node *z = new pairing_node(c->key);
+				if (last)
+				{
+					last->next = z;
+					z->prev = last;
+				}
+				else
+				{
+					to->child = z;
+					z->prev = to;
+				}
+				last = z;
+				todo.push_back(std::make_pair(c, z));
+			}
+		}
 	}
 
-	/**
-	* return the number of the elements.
-	*/
-	size_t size() const { return heap->size(); }
+	//Release all the nodes without recursion: the first child of the current node is turned into the node
+	//to be released just before it, until the current node has no child and can be deleted.
+	void destroy()
+	{
+		pairing_node *cur = root;
+		while (cur)
+		{
+			if (cur->child)
+			{
+				pairing_node *c = cur->child;
+				cur->child = c->next;
+				c->next = cur;
+				cur = c;
+			}
+			else
+			{
+				pairing_node *z = cur;
+				cur = cur->next;
+				delete z;
+			}
+		}
+		root = nullptr;
+		n = 0;
+	}
 
-	/**
-	* check if the container has at least an element.
-	* @return true if it is empty, false if it has at least an element.
-	*/
-	bool empty() const { return heap->empty(); }
+	void exchange(pairing_heap &rhs)
+	{
+		using std::swap;
+		swap(n, rhs.n);
+		swap(root, rhs.root);
+		swap(cmp, rhs.cmp);
+	}
+
+public:
+	//refers to an element in the heap, valid until the element is popped or erased.
+	class handle
+	{
+		friend class pairing_heap;
+
+	private:
+		pairing_node *node;
+
+		handle(pairing_node *p) :node(p) {}
+
+	public:
+		handle() :node(nullptr) {}
+
+		bool operator==(const handle &rhs) const { return node == rhs.node; }
+		bool operator!=(const handle &rhs) const { return node != rhs.node; }
+	};
+
+	pairing_heap() :n(0), root(nullptr) {}
+	pairing_heap(const Compare &x) :n(0), root(nullptr), cmp(x) {}
+
+	pairing_heap(const pairing_heap &rhs) :n(0), root(nullptr), cmp(rhs.cmp)
+	{
+		try {
+			duplicate(rhs);
+		} catch (...) {
+			destroy();
+			throw;
+		}
+		n = rhs.n;
+	}
+
+	~pairing_heap() { destroy(); }
+
+	pairing_heap& operator=(pairing_heap rhs)
+	{
+		exchange(rhs);
+		return *this;
+	}
+
+	bool empty() const { return n == 0; }
+
+	size_t size() const { return n; }
+
+	const T& front() const
+	{
+		if (!root)
+			throw container_is_empty();
+
+		return root->key;
+	}
+
+	handle push_back(const T &_key)
+	{
+		auto tmp = new pairing_node(_key);
+		root = root ? meld(root, tmp) : tmp;
+		n++;
+		return handle(tmp);
+	}
+
+	void pop_front()
+	{
+		auto z = root;
+		root = combine(root->child);
+		delete z;
+		n--;
+	}
+
+	//Push all the elements of [first, last): the new nodes are put in a list of siblings,
+	//the best of which takes the others as its children and is melded with the top at once.
+	//As with push_back, pairing them is left to the next pop_front.
+	template<class InputIterator>
+	void push_range(InputIterator first, InputIterator last)
+	{
+		pairing_node *list = nullptr, *best = nullptr;
+		size_t m = 0;
+		try {
+			for (; first != last; ++first, ++m)
+			{
+				auto z = new pairing_node(*first);
+				z->next = list;
+				if (list)
+					list->prev = z;
+				list = z;
+				if (!best || cmp(best->key, z->key))
+					best = z;
+			}
+		} catch (...) {
+			meldList(list, best, m);//keep the elements pushed so far
+			throw;
+		}
+		meldList(list, best, m);
+	}
+
+	const T& get(const handle &h) const
+	{
+		if (!h.node)
+			throw invalid_iterator();
+
+		return h.node->key;
+	}
+
+	//Replace the key of the element referred to by h with _key, which must not be worse than the old one.
+	//Throw runtime_error otherwise.
+	void decrease_key(const handle &h, const T &_key)
+	{
+		auto x = h.node;
+		if (!x)
+			throw invalid_iterator();
+		if (cmp(_key, x->key))
+			throw runtime_error();
+
+		x->key = _key;
+		if (x != root)
+		{
+			detach(x);
+			root = meld(root, x);
+		}
+	}
+
+	//Remove the element referred to by h: its children are combined and melded back with the top.
+	void erase(const handle &h)
+	{
+		auto x = h.node;
+		if (!x)
+			throw invalid_iterator();
+
+		if (x == root)
+		{
+			pop_front();
+			return;
+		}
+
+		detach(x);
+		auto sub = combine(x->child);
+		if (sub)
+			root = meld(root, sub);
+		delete x;
+		n--;
+	}
+
+	//Meld the root of rhs into this heap in O(1) and leave rhs empty.
+	//The handles of rhs stay valid and now refer to elements of this heap.
+	void merge(pairing_heap &rhs)
+	{
+		if (&rhs == this || !rhs.root)
+			return;
+
+		root = root ? meld(root, rhs.root) : rhs.root;
+		n += rhs.n;
+		rhs.root = nullptr;
+		rhs.n = 0;
+	}
+};
+
+//A radix heap for the internal heap of a priority_queue, for integer keys which are taken out in non-decreasing order,
+//as in Dijkstra or an event simulation. The elements are pairs of a key and a value, and the smallest key is the top,
+//so it matches priority_queue<std::pair<Key, Value>, std::greater<std::pair<Key, Value> >, radix_heap<Key, Value> >.
+//A key goes to the bucket given by the highest bit in which it differs from the last key taken out, so push is O(1),
+//and each element moves only to lower buckets, for O(log(C)) amortised time per pop with no comparisons of keys.
+//A key pushed must not be less than the last key taken out by front or pop_front, otherwise runtime_error is thrown.
+template<typename Key, typename Value>
+class radix_heap
+{
+	static_assert(std::is_integral<Key>::value, "the keys of a radix heap must be integers");
+
+public:
+	typedef std::pair<Key, Value> value_type;
+
+private:
+	typedef typename std::make_unsigned<Key>::type ukey;
+	static const size_t bits = std::numeric_limits<ukey>::digits;
+
+	//bucket 0 holds the keys equal to last, bucket i the keys whose highest bit differing from last is bit i-1.
+	//front is const in priority_queue, but it may have to redistribute the lowest bucket, hence mutable.
+	mutable vector<value_type> bucket[bits + 1];
+	mutable ukey last;
+	size_t n;
+
+	//map the keys to unsigned ones in the same order
+	static ukey encode(Key k)
+	{
+		return std::is_signed<Key>::value ? (ukey)k ^ ((ukey)1 << (bits - 1)) : (ukey)k;
+	}
+
+	//the number of significant bits of x, in log(bits) steps
+	static size_t width(ukey x)
+	{
+		size_t w = 0;
+		for (size_t s = bits / 2; s > 0; s /= 2)
+		{
+			if (x >> s)
+			{
+				x >>= s;
+				w += s;
+			}
+		}
+		return w + (x ? 1 : 0);
+	}
+
+	size_t bucket_of(ukey k) const { return width(k ^ last); }
+
+	//Make bucket 0 non-empty: take the smallest key of the first non-empty bucket as last,
+	//and redistribute that bucket, whose elements all go to lower ones.
+	void pull() const
+	{
+		if (!bucket[0].empty())
+			return;
+
+		size_t i = 1;
+		while (bucket[i].empty())
+			i++;
+
+		vector<value_type> &b = bucket[i];
+		ukey m = encode(b[0].first);
+		for (size_t j = 1; j < b.size(); j++)
+			m = std::min(m, encode(b[j].first));
+
+		last = m;
+		for (size_t j = 0; j < b.size(); j++)
+			bucket[width(encode(b[j].first) ^ last)].push_back(std::move(b[j]));
+		b.clear();
+	}
+
+public:
+	radix_heap() :last(0), n(0) {}
+
+	bool empty() const { return n == 0; }
+
+	size_t size() const { return n; }
+
+	const value_type& front() const
+	{
+		if (n == 0)
+			throw container_is_empty();
+
+		pull();
+		return bucket[0].back();
+	}
+
+	void push_back(const value_type &elem)
+	{
+		ukey k = encode(elem.first);
+		if (k < last)
+			throw runtime_error();
+
+		bucket[bucket_of(k)].push_back(elem);
+		n++;
+	}
+
+	void pop_front()
+	{
+		pull();
+		bucket[0].pop_back();
+		n--;
+	}
+
+	//Push all the elements of [first, last), each in O(1).
+	template<class InputIterator>
+	void push_range(InputIterator first, InputIterator last)
+	{
+		for (; first != last; ++first)
+			push_back(*first);
+	}
+
+	//Move all the elements of rhs into this heap in O(m) and leave rhs empty.
+	//Throw runtime_error and change nothing if rhs has a key less than the last one taken out of this heap.
+	void merge(radix_heap &rhs)
+	{
+		if (&rhs == this || rhs.empty())
+			return;
+
+		for (size_t i = 0; i <= bits; i++)
+			for (size_t j = 0; j < rhs.bucket[i].size(); j++)
+				if (encode(rhs.bucket[i][j].first) < last)
+					throw runtime_error();
+
+		for (size_t i = 0; i <= bits; i++)
+		{
+			vector<value_type> &b = rhs.bucket[i];
+			for (size_t j = 0; j < b.size(); j++)
+				bucket[bucket_of(encode(b[j].first))].push_back(std::move(b[j]));
+			b.clear();
+		}
+		n += rhs.n;
+		rhs.n = 0;
+	}
+};
+
+//A container like std::priority_queue which is a heap internal.
+template<typename T, class Compare = std::less<T>, typename HeapTypeDef = fibonacci_heap<T, Compare> >
+class priority_queue
+{
+private:
+	HeapTypeDef *heap;
+
+	void swap(priority_queue &other) { std::swap(heap, other.heap); }
+
+public:
+	//what push returns: the handle of the new element if the heap provides one, otherwise void
+	typedef decltype(std::declval<HeapTypeDef&>().push_back(std::declval<const T&>())) handle_type;
+
+	/**
+	* constructors
+	*/
+	priority_queue() :heap(new HeapTypeDef()) {}
+	priority_queue(const priority_queue &other) :heap(new HeapTypeDef(*(other.heap))) {}
+
+	/**
+	* build the priority queue from the elements of [first, last) by push_range,
+	* in O(n) for binary_heap and dary_heap instead of n pushes of O(log(n)) each.
+	*/
+	template<class InputIterator>
+	priority_queue(InputIterator first, InputIterator last) :heap(new HeapTypeDef())
+	{
+		try {
+			heap->push_range(first, last);
+		} catch (...) {
+			delete heap;
+			throw;
+		}
+	}
+
+	/**
+	* deconstructor
+	*/
+	~priority_queue() { delete heap; }
+
+	/**
+	* Assignment operator
+	*/
+	priority_queue &operator=(const priority_queue &other)
+	{
+		priority_queue tmp(other);
+		swap(tmp);
+		return *this;
+	}
+
+	/**
+	* get the top of the queue.
+	* @return a reference of the top element.
+	* throw container_is_empty if empty() returns true;
+	*/
+	const T & top() const
+	{
+		if (empty())
+			throw container_is_empty();
+
+		return heap->front();
+	}
+
+	/**
+	* push new element to the priority queue.
+	* @return what the heap returns, e.g. the handle of the new element for fibonacci_heap and pairing_heap.
+	*/
+	handle_type push(const T &e) { return heap->push_back(e); }
+
+	/**
+	* push all the elements of [first, last).
+	* the heap is restored only once, which costs O(n+m) at most for binary_heap and dary_heap,
+	* while fibonacci_heap and pairing_heap link the new elements among themselves first.
+	*/
+	template<class InputIterator>
+	void push_range(InputIterator first, InputIterator last) { heap->push_range(first, last); }
+
+	/**
+	* the following ones are only available when the heap provides handles, like fibonacci_heap and pairing_heap.
+	* get the element referred to by h.
+	*/
+	template<typename Heap = HeapTypeDef>
+	const T & get(const typename Heap::handle &h) const { return heap->get(h); }
+
+	/**
+	* move the element referred to by h towards the top by giving it a better key.
+	* throw runtime_error if e is worse than the current key.
+	*/
+	template<typename Heap = HeapTypeDef>
+	void decrease_key(const typename Heap::handle &h, const T &e) { heap->decrease_key(h, e); }
+
+	/**
+	* delete the element referred to by h.
+	*/
+	template<typename Heap = HeapTypeDef>
+	void erase(const typename Heap::handle &h) { heap->erase(h); }
+
+	/**
+	* delete the top element.
+	* throw container_is_empty if empty() returns true;
+	*/
+	void pop()
+	{
+		if (empty())
+			throw container_is_empty();
+
+		heap->pop_front();
+	}
+
+	/**
+	* move all the elements of other into this priority queue, leaving other empty.
+	* O(1) with fibonacci_heap and pairing_heap, O(n+m) at most with binary_heap and dary_heap.
+	*/
+	void merge(priority_queue &other) { heap->merge(*other.heap); }
+
+	/**
+	* return the number of the elements.
+	*/
+	size_t size() const { return heap->size(); }
+
+	/**
+	* check if the container has at least an element.
+	* @return true if it is empty, false if it has at least an element.
+	*/
+	bool empty() const { return heap->empty(); }
+};
+
+//A priority queue of the elements given by dense integer ids, for graph algorithms over vertex ids.
+//It is a d-ary heap of (priority, id) entries on a vector, together with a vector from each id to its slot,
+//so that the priority of any id can be changed or the id removed in O(log(n)) without allocating anything.
+//As in priority_queue, the top is the greatest one under Compare.
+template<typename Priority, class Compare = std::less<Priority>, size_t D = 4>
+class indexed_priority_queue
+{
+	static_assert(D >= 2, "a d-ary heap needs at least two children for each node");
+
+private:
+	struct entry
+	{
+		Priority p;
+		size_t id;
+
+		entry(const Priority &_p, size_t _id) :p(_p), id(_id) {}
+	};
+
+	static const size_t npos = (size_t)-1;
+
+	vector<entry> heap;
+	vector<size_t> slot;//slot[id] is where id is in heap, or npos if it is not in the queue
+	Compare cmp;
+
+	static size_t parent(size_t i) { return (i - 1) / D; }
+	static size_t first_child(size_t i) { return D * i + 1; }
+
+	void percolateUp(size_t pos)
+	{
+		entry tmp(std::move(heap[pos]));
+		while (pos > 0)
+		{
+			size_t father = parent(pos);
+			if (!cmp(heap[father].p, tmp.p))
+				break;
+			heap[pos] = std::move(heap[father]);
+			slot[heap[pos].id] = pos;
+			pos = father;
+		}
+		slot[tmp.id] = pos;
+		heap[pos] = std::move(tmp);
+	}
+
+	void percolateDown(size_t pos)
+	{
+		const size_t n = heap.size();
+		entry tmp(std::move(heap[pos]));
+		size_t child;
+		while ((child = first_child(pos)) < n)
+		{
+			size_t last = std::min(child + D, n), best = child;
+			for (++child; child < last; ++child)
+				if (cmp(heap[best].p, heap[child].p))
+					best = child;
+
+			if (!cmp(tmp.p, heap[best].p))
+				break;
+			heap[pos] = std::move(heap[best]);
+			slot[heap[pos].id] = pos;
+			pos = best;
+		}
+		slot[tmp.id] = pos;
+		heap[pos] = std::move(tmp);
+	}
+
+	//the slot of id, throw index_out_of_bound if id is not in the queue
+	size_t find(size_t id) const
+	{
+		if (!contains(id))
+			throw index_out_of_bound();
+
+		return slot[id];
+	}
+
+public:
+	//ids are expected in [0, n), though a greater one makes the queue grow.
+	indexed_priority_queue(size_t n = 0) :slot(n, npos) {}
+	indexed_priority_queue(size_t n, const Compare &x) :slot(n, npos), cmp(x) {}
+
+	size_t size() const { return heap.size(); }
+
+	bool empty() const { return heap.empty(); }
+
+	bool contains(size_t id) const { return id < slot.size() && slot[id] != npos; }
+
+	/**
+	* the priority and the id of the top.
+	* throw container_is_empty if empty() returns true.
+	*/
+	const Priority& top() const
+	{
+		if (empty())
+			throw container_is_empty();
+
+		return heap[0].p;
+	}
+
+	size_t top_id() const
+	{
+		if (empty())
+			throw container_is_empty();
+
+		return heap[0].id;
+	}
+
+	/**
+	* the priority of id.
+	* throw index_out_of_bound if id is not in the queue.
+	*/
+	const Priority& get(size_t id) const { return heap[find(id)].p; }
+
+	/**
+	* insert id with priority p.
+	* throw runtime_error if id is already in the queue.
+	*/
+	void push(size_t id, const Priority &p)
+	{
+		if (contains(id))
+			throw runtime_error();
+
+		while (slot.size() <= id)
+			slot.push_back(npos);
+		heap.push_back(entry(p, id));
+		percolateUp(heap.size() - 1);
+	}
+
+	/**
+	* give id a priority p not worse than its current one, moving it towards the top.
+	* throw runtime_error if p is worse, or index_out_of_bound if id is not in the queue.
+	*/
+	void decrease_key(size_t id, const Priority &p)
+	{
+		size_t pos = find(id);
+		if (cmp(p, heap[pos].p))
+			throw runtime_error();
+
+		heap[pos].p = p;
+		percolateUp(pos);
+	}
+
+	/**
+	* give id a priority p not better than its current one, moving it away from the top.
+	* throw runtime_error if p is better, or index_out_of_bound if id is not in the queue.
+	*/
+	void increase_key(size_t id, const Priority &p)
+	{
+		size_t pos = find(id);
+		if (cmp(heap[pos].p, p))
+			throw runtime_error();
+
+		heap[pos].p = p;
+		percolateDown(pos);
+	}
+
+	/**
+	* delete the top.
+	* throw container_is_empty if empty() returns true.
+	*/
+	void pop()
+	{
+		if (empty())
+			throw container_is_empty();
+
+		erase(heap[0].id);
+	}
+
+	/**
+	* delete id: the last entry is moved into its slot and percolated either way.
+	* throw index_out_of_bound if id is not in the queue.
+	*/
+	void erase(size_t id)
+	{
+		size_t pos = find(id);
+		slot[id] = npos;
+
+		const size_t last = heap.size() - 1;
+		if (pos != last)
+		{
+			heap[pos] = std::move(heap[last]);
+			heap.pop_back();
+			if (pos > 0 && cmp(heap[parent(pos)].p, heap[pos].p))
+				percolateUp(pos);
+			else
+				percolateDown(pos);
+		}
+		else
+			heap.pop_back();
+	}
+};
+
+template<typename Priority, class Compare, size_t D>
+const size_t indexed_priority_queue<Priority, Compare, D>::npos;
+
+//Keeps the best k elements of a stream, i.e. the k greatest ones under Compare, as the tops of a priority_queue would be,
+//in O(k) memory and O(log(k)) time for each element taken in.
+//The elements kept are in a fixed-capacity heap with the worst of them on the top, which is the threshold
+//a new element has to beat, so most elements of a long stream are rejected by one comparison.
+template<typename T, class Compare = std::less<T> >
+class topk
+{
+private:
+	static const size_t block = 32;//elements checked at once by the filter of offer_range
+
+	T *c;//c[0] is the worst one kept
+	size_t n, k;
+	Compare cmp;
+
+	static size_t parent(size_t i) { return (i - 1) / 2; }
+	static size_t left(size_t i) { return 2 * i + 1; }
+
+	//the heap is upside down: a parent is never better than its children
+	void percolateUp(size_t pos)
+	{
+		T tmp(std::move(c[pos]));
+		while (pos > 0)
+		{
+			size_t father = parent(pos);
+			if (!cmp(tmp, c[father]))
+				break;
+			c[pos] = std::move(c[father]);
+			pos = father;
+		}
+		c[pos] = std::move(tmp);
+	}
+
+	//put tmp into the hole at pos and move it down among the first len elements
+	void percolateDown(size_t pos, T &tmp, size_t len)
+	{
+		size_t child;
+		while ((child = left(pos)) < len)
+		{
+			if (child + 1 < len && cmp(c[child + 1], c[child]))
+				++child;
+			if (!cmp(c[child], tmp))
+				break;
+			c[pos] = std::move(c[child]);
+			pos = child;
+		}
+		c[pos] = std::move(tmp);
+	}
+
+	template<class InputIterator>
+	void offer_range(InputIterator first, InputIterator last, std::false_type)
+	{
+		for (; first != last; ++first)
+			offer(*first);
+	}
+
+	//For arithmetic elements in contiguous storage, each block is first checked against the threshold
+	//by a loop without branches, which the compiler turns into SIMD compares, and only a block
+	//with some element beating the threshold is offered element by element.
+	void offer_range(const T *first, const T *last, std::true_type)
+	{
+		while (first != last && n < k)
+			offer(*first++);
+		if (k == 0)
+			return;
+
+		for (; last - first >= (std::ptrdiff_t)block; first += block)
+		{
+			const T threshold = c[0];
+			unsigned char hit = 0;
+			for (size_t j = 0; j < block; j++)
+				hit |= (unsigned char)cmp(threshold, first[j]);
+			if (hit)
+			{
+				for (size_t j = 0; j < block; j++)
+					offer(first[j]);
+			}
+		}
+		for (; first != last; ++first)
+			offer(*first);
+	}
+
+public:
+	topk(size_t _k, const Compare &x = Compare()) :c(nullptr), n(0), k(_k), cmp(x)
+	{
+		if (k > 0)
+		{
+			c = (T*)std::malloc(k * sizeof(T));
+			if (!c)
+				throw std::bad_alloc();
+		}
+	}
+
+	topk(const topk &other) :c(nullptr), n(0), k(other.k), cmp(other.cmp)
+	{
+		if (k > 0)
+		{
+			c = (T*)std::malloc(k * sizeof(T));
+			if (!c)
+				throw std::bad_alloc();
+		}
+		try {
+			for (; n < other.n; n++)
+				new (c + n) T(other.c[n]);
+		} catch (...) {
+			clear();
+			std::free(c);
+			throw;
+		}
+	}
+
+	~topk()
+	{
+		clear();
+		std::free(c);
+	}
+
+	topk &operator=(topk rhs)
+	{
+		using std::swap;
+		swap(c, rhs.c);
+		swap(n, rhs.n);
+		swap(k, rhs.k);
+		swap(cmp, rhs.cmp);
+		return *this;
+	}
+
+	size_t size() const { return n; }
+
+	size_t capacity() const { return k; }
+
+	bool empty() const { return n == 0; }
+
+	bool full() const { return n == k; }
+
+	/**
+	* the worst element kept, which a new one has to beat once k elements are kept.
+	* throw container_is_empty if empty() returns true.
+	*/
+	const T &threshold() const
+	{
+		if (empty())
+			throw container_is_empty();
+
+		return c[0];
+	}
+
+	/**
+	* take elem in if fewer than k elements are kept or it beats the threshold, which is then dropped.
+	* @return whether elem is kept.
+	*/
+	bool offer(const T &elem)
+	{
+		if (n < k)
+		{
+			new (c + n) T(elem);
+			percolateUp(n++);
+			return true;
+		}
+		if (k == 0 || !cmp(c[0], elem))
+			return false;
+
+		T tmp(elem);
+		percolateDown(0, tmp, n);
+		return true;
+	}
+
+	/**
+	* offer all the elements of [first, last).
+	* with arithmetic elements behind pointers, whole blocks below the threshold are skipped by SIMD compares.
+	*/
+	template<class InputIterator>
+	void offer_range(InputIterator first, InputIterator last)
+	{
+		offer_range(first, last, std::integral_constant<bool,
+			std::is_arithmetic<T>::value && std::is_convertible<InputIterator, const T*>::value>());
+	}
+
+	void clear()
+	{
+		for (size_t i = 0; i < n; i++)
+			c[i].~T();
+		n = 0;
+	}
+
+	/**
+	* drain the elements kept, the best first, by sorting the heap in place.
+	*/
+	vector<T> sorted_result()
+	{
+		for (size_t len = n; len > 1; len--)
+		{
+			T tmp(std::move(c[len - 1]));
+			c[len - 1] = std::move(c[0]);
+			percolateDown(0, tmp, len - 1);
+		}
+
+		vector<T> result;
+		for (size_t i = 0; i < n; i++)
+			result.push_back(std::move(c[i]));
+		clear();
+		return result;
+	}
+};
+
+//A priority_queue whose elements may outgrow the memory, for trivially copyable elements.
+//New elements go into an insertion heap of HeapTypeDef. When it holds half of the memory budget,
+//it is drained in order into a sorted run in a temporary file, and a pop takes the better of the heap top
+//and the best head of the runs, which are kept in a binary_heap of their own.
+//A run is read and written a block at a time. The other half of the budget holds the blocks: one for each run,
+//one being written and one more for a merge, and once a new run would not fit, all the runs are merged into one.
+//The insertion heap is counted as sizeof(T) for each element, so the spare room and the nodes of its backend
+//come on top of the budget, which is only approximate for them.
+//A runtime_error from the files leaves the queue unusable, as the elements being moved are lost with the run.
+template<typename T, class Compare = std::less<T>, typename HeapTypeDef = binary_heap<T, Compare> >
+class external_priority_queue
+{
+	static_assert(std::is_trivially_copyable<T>::value, "the elements are written to files byte by byte");
+
+private:
+	//a sorted run, the best first, with the block being read
+	struct run
+	{
+		std::FILE *file;
+		size_t left;//elements still in the file
+		T *buf;
+		size_t pos, len;
+
+		const T &head() const { return buf[pos]; }
+	};
+
+	//compares the runs by their heads
+	struct headCompare
+	{
+		Compare cmp;
+
+		bool operator()(const run *a, const run *b) const { return cmp(a->head(), b->head()); }
+	};
+
+	HeapTypeDef heap;
+	sjtu::vector<run*> runs;
+	binary_heap<run*, headCompare> runHeap;//the runs which are not exhausted
+	T *out;//the block being written
+	size_t n;
+	size_t blockSize, heapCap, maxRuns;//in elements, elements and runs
+	Compare cmp;
+
+	//read the next block of r. return false if r is exhausted
+	bool refill(run *r)
+	{
+		const size_t m = r->left < blockSize ? r->left : blockSize;
+		if (m > 0 && std::fread(r->buf, sizeof(T), m, r->file) != m)
+			throw runtime_error();
+
+		r->left -= m;
+		r->pos = 0;
+		r->len = m;
+		return m > 0;
+	}
+
+	//move on to the next element of r, and close r once it is exhausted
+	void advance(run *r)
+	{
+		if (++r->pos < r->len || refill(r))
+			runHeap.push_back(r);
+		else
+			destroyRun(r);
+	}
+
+	run *newRun()
+	{
+		run *r = new run();
+		r->file = std::tmpfile();
+		r->buf = (T*)std::malloc(blockSize * sizeof(T));
+		if (!r->file || !r->buf)
+		{
+			destroyRun(r);
+			throw runtime_error();
+		}
+		std::setvbuf(r->file, nullptr, _IONBF, 0);//the blocks are buffered already
+		r->left = r->pos = r->len = 0;
+		return r;
+	}
+
+	//forget r, which is not in runHeap
+	void destroyRun(run *r)
+	{
+		for (size_t i = 0; i < runs.size(); i++)
+		{
+			if (runs[i] == r)
+			{
+				runs[i] = runs.back();
+				runs.pop_back();
+				break;
+			}
+		}
+		if (r->file)
+			std::fclose(r->file);
+		std::free(r->buf);
+		delete r;
+	}
+
+	void write(run *r, size_t m)
+	{
+		if (m > 0 && std::fwrite(out, sizeof(T), m, r->file) != m)
+			throw runtime_error();
+		r->left += m;
+	}
+
+	//rewind r after m more elements from out, and put it among the runs
+	void finish(run *r, size_t m)
+	{
+		write(r, m);
+		std::rewind(r->file);
+		runs.push_back(r);
+		if (refill(r))
+			runHeap.push_back(r);
+		else
+			destroyRun(r);
+	}
+
+	//write the whole insertion heap into a new run
+	void spill()
+	{
+		if (runs.size() >= maxRuns)
+			mergeRuns();
+
+		run *r = newRun();
+		try {
+			size_t m = 0;
+			while (!heap.empty())
+			{
+				out[m++] = heap.front();
+				heap.pop_front();
+				if (m == blockSize)
+				{
+					write(r, m);
+					m = 0;
+				}
+			}
+			finish(r, m);
+		} catch (...) {
+			destroyRun(r);
+			throw;
+		}
+	}
+
+	//merge all the runs into one
+	void mergeRuns()
+	{
+		run *r = newRun();
+		try {
+			size_t m = 0;
+			while (!runHeap.empty())
+			{
+				run *from = runHeap.front();
+				runHeap.pop_front();
+				out[m++] = from->head();
+				advance(from);
+				if (m == blockSize)
+				{
+					write(r, m);
+					m = 0;
+				}
+			}
+			finish(r, m);
+		} catch (...) {
+			destroyRun(r);
+			throw;
+		}
+	}
+
+	//whether the top is the head of a run rather than the top of the insertion heap
+	bool topInRun() const
+	{
+		return !runHeap.empty() && (heap.empty() || cmp(heap.front(), runHeap.front()->head()));
+	}
+
+public:
+	/**
+	* memory is the budget in bytes for the elements kept in memory, and block is the size in bytes
+	* of a single read or write. Both are at least one element, and there are always blocks for two runs,
+	* even if the budget is less than that.
+	* the runs are written by std::tmpfile into the temporary directory of the system.
+	*/
+	explicit external_priority_queue(size_t memory = (size_t)64 << 20, size_t block = (size_t)1 << 16) :n(0)
+	{
+		blockSize = block < sizeof(T) ? 1 : block / sizeof(T);
+		const size_t half = memory / 2 / sizeof(T);
+		heapCap = half > blockSize ? half : blockSize;
+		const size_t rest = memory > heapCap * sizeof(T) ? memory - heapCap * sizeof(T) : 0;
+		const size_t blocks = rest / (blockSize * sizeof(T));//for the runs, the one being written and out
+		maxRuns = blocks < 4 ? 2 : blocks - 2;
+		out = (T*)std::malloc(blockSize * sizeof(T));
+		if (!out)
+			throw std::bad_alloc();
+	}
+
+	external_priority_queue(const external_priority_queue &) = delete;
+	external_priority_queue &operator=(const external_priority_queue &) = delete;
+
+	~external_priority_queue()
+	{
+		while (!runs.empty())
+			destroyRun(runs.back());
+		std::free(out);
+	}
+
+	/**
+	* get the top of the queue.
+	* @return a reference of the top element.
+	* throw container_is_empty if empty() returns true;
+	*/
+	const T &top() const
+	{
+		if (empty())
+			throw container_is_empty();
+
+		return topInRun() ? runHeap.front()->head() : heap.front();
+	}
+
+	/**
+	* push new element to the priority queue, which may write the insertion heap into a new run.
+	* throw runtime_error if a temporary file can't be created or written, after which the queue can only be destroyed.
+	*/
+	void push(const T &e)
+	{
+		heap.push_back(e);
+		++n;
+		if (heap.size() >= heapCap)
+			spill();
+	}
+
+	/**
+	* delete the top element.
+	* throw container_is_empty if empty() returns true;
+	* throw runtime_error if a run can't be read, after which the queue can only be destroyed.
+	*/
+	void pop()
+	{
+		if (empty())
+			throw container_is_empty();
+
+		if (topInRun())
+		{
+			run *r = runHeap.front();
+			runHeap.pop_front();
+			advance(r);
+		}
+		else
+			heap.pop_front();
+		--n;
+	}
+
+	size_t size() const { return n; }
+
+	bool empty() const { return n == 0; }
+
+	//the number of runs in temporary files
+	size_t runs_on_disk() const { return runs.size(); }
 };
 }
 #endif
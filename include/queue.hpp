@@ -1,25 +1,29 @@
 #ifndef SJTU_QUEUE_HPP
 #define SJTU_QUEUE_HPP
 
+#include "ring_buffer.hpp"
 #include "list.hpp"
 #include "exceptions.hpp"
 
 #include <cstdlib>
 #include <algorithm>
+#include <utility>
 
 namespace sjtu 
 {
 /**
  * a container whose behavior is similar to a queue.
- * It should be based on the list you had written before.
+ * The default ListType is ring_buffer, which keeps the elements in a successive circular buffer,
+ * and sjtu::list can be used as well, e.g. queue<T, list<T>>.
  */
-template<typename T>
+template<typename T, typename ListType = ring_buffer<T>>
 class queue 
 {
 private:
-	typedef sjtu::list<T> ContainerTypeDef;
+	typedef ListType ContainerTypeDef;
 	
-	ContainerTypeDef *container;
+	//held by value, so that creating a queue costs no extra allocation and an access no extra indirection
+	ContainerTypeDef container;
 
 	void swap(queue &rhs)
 	{
@@ -31,26 +35,16 @@ public:
 	/**
 	 * constructors
 	 */
-	queue() 
-	{
-		container = (ContainerTypeDef*)malloc(sizeof(ContainerTypeDef));
-		new (container) ContainerTypeDef();
-	}
+	queue() {}
 
-	queue(const queue<T> &other) 
-	{
-		container = (ContainerTypeDef*)malloc(sizeof(ContainerTypeDef));
-		new (container) ContainerTypeDef(*(other.container));
-	}
+	queue(const queue &other) :
+		container(other.container)
+	{}
 
-	/**
-	 * deconstructor
-	 */
-	~queue() 
-	{
-		container->~ContainerTypeDef();
-		free(container);
-	}
+	//take over the elements of other, which is left empty
+	queue(queue &&other) :
+		container(std::move(other.container))
+	{}
 
 	/**
 	 * Assignment operator
@@ -71,13 +65,34 @@ public:
 		if (empty())
 			throw container_is_empty();
 
-		return container->front();
+		return container.front();
 	}
 
 	/**
 	 * push new element to the queue.
 	 */
-	void push(const T &e) { container->push_back(e); }
+	void push(const T &e) { container.push_back(e); }
+
+	void push(T &&e) { container.push_back(std::move(e)); }
+
+	/**
+	 * construct a new element at the back from args.
+	 */
+	template<typename... Args>
+	void emplace(Args&&... args)
+	{
+		container.emplace_back(std::forward<Args>(args)...);
+	}
+
+	/**
+	 * push the elements in [first, last) in order.
+	 */
+	template<typename InputIt>
+	void push_bulk(InputIt first, InputIt last)
+	{
+		for (; first != last; ++first)
+			container.push_back(*first);
+	}
 
 	/**
 	 * delete the first element.
@@ -88,14 +103,31 @@ public:
 		if (empty())
 			throw container_is_empty();
 		
-		container->pop_front();
+		container.pop_front();
 	}
+
+	/**
+	 * pop at most max elements from the front and move them to out in order.
+	 * @return the number of popped elements.
+	 */
+	template<typename OutputIt>
+	size_t pop_bulk(OutputIt out, size_t max)
+	{
+		size_t cnt = 0;
+		for (; cnt < max && !container.empty(); ++cnt, ++out)
+		{
+			*out = std::move(container.front());
+			container.pop_front();
+		}
+		return cnt;
+	}
+
 	/**
 	 * return the number of the elements.
 	 */
 	size_t size() const 
 	{ 
-		return container->size(); 
+		return container.size(); 
 	}
 
 	/**
@@ -104,7 +136,7 @@ public:
 	 */
 	bool empty() const 
 	{ 
-		return container->empty();
+		return container.empty();
 	}
 };
 
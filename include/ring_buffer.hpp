@@ -0,0 +1,202 @@
+#ifndef SJTU_RING_BUFFER_HPP
+#define SJTU_RING_BUFFER_HPP
+
+#include "exceptions.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <algorithm>
+#include <utility>
+
+namespace sjtu
+{
+	//a circular buffer in a successive memory, used as the default container of queue.
+	//The capacity is always a power of two, so that the position of an element is found by a mask,
+	//and it is doubled when the buffer is full, which makes push_back amortised O(1).
+	template<typename T>
+	class ring_buffer
+	{
+	private:
+		T *start;
+		size_t head;//position of the first element
+		size_t validLen;
+		size_t mask;//capacity - 1, or 0 when nothing is allocated
+
+		void exchange(ring_buffer &rhs)
+		{
+			std::swap(start, rhs.start);
+			std::swap(head, rhs.head);
+			std::swap(validLen, rhs.validLen);
+			std::swap(mask, rhs.mask);
+		}
+
+		//address of the i-th element
+		T* slot(size_t i) const
+		{
+			return start + ((head + i) & mask);
+		}
+
+		//move the elements into a new buffer of twice the capacity, starting from position 0
+		void doubleSpace()
+		{
+			const size_t newCap = start ? 2 * (mask + 1) : 8;
+			T *data = (T *)std::malloc(newCap * sizeof(T));
+			for (size_t i = 0; i < validLen; i++)
+			{
+				T *p = slot(i);
+				new (data + i) T(std::move(*p));
+				p->~T();
+			}
+
+			std::free(start);
+			start = data;
+			head = 0;
+			mask = newCap - 1;
+		}
+
+	public:
+		ring_buffer() :
+			start(nullptr),
+			head(0),
+			validLen(0),
+			mask(0)
+		{}
+
+		ring_buffer(const ring_buffer &rhs) :
+			start(nullptr),
+			head(0),
+			validLen(0),
+			mask(0)
+		{
+			if (rhs.validLen == 0)
+				return;
+
+			size_t cap = 8;
+			while (cap < rhs.validLen)
+				cap *= 2;
+
+			start = (T *)std::malloc(cap * sizeof(T));
+			mask = cap - 1;
+			for (; validLen < rhs.validLen; validLen++)
+				new (start + validLen) T(*rhs.slot(validLen));
+		}
+
+		//take over the buffer of rhs, which is left empty
+		ring_buffer(ring_buffer &&rhs) :
+			start(rhs.start),
+			head(rhs.head),
+			validLen(rhs.validLen),
+			mask(rhs.mask)
+		{
+			rhs.start = nullptr;
+			rhs.head = rhs.validLen = rhs.mask = 0;
+		}
+
+		~ring_buffer()
+		{
+			clear();
+			std::free(start);
+		}
+
+		ring_buffer& operator=(ring_buffer rhs)
+		{
+			exchange(rhs);
+			return *this;
+		}
+
+		const T& front() const
+		{
+			if (empty())
+				throw container_is_empty();
+
+			return *slot(0);
+		}
+
+		T& front()
+		{
+			if (empty())
+				throw container_is_empty();
+
+			return *slot(0);
+		}
+
+		const T& back() const
+		{
+			if (empty())
+				throw container_is_empty();
+
+			return *slot(validLen - 1);
+		}
+
+		T& back()
+		{
+			if (empty())
+				throw container_is_empty();
+
+			return *slot(validLen - 1);
+		}
+
+		void push_back(const T &value)
+		{
+			emplace_back(value);
+		}
+
+		void push_back(T &&value)
+		{
+			emplace_back(std::move(value));
+		}
+
+		//construct a new element at the end from args
+		template<typename... Args>
+		void emplace_back(Args&&... args)
+		{
+			if (validLen == mask + 1 || !start)
+			{
+				//args may refer to an element inside, so build the new element before the buffer moves
+				T value(std::forward<Args>(args)...);
+				doubleSpace();
+				new (slot(validLen)) T(std::move(value));
+			}
+			else
+				new (slot(validLen)) T(std::forward<Args>(args)...);
+			++validLen;
+		}
+
+		void pop_front()
+		{
+			if (empty())
+				throw container_is_empty();
+
+			slot(0)->~T();
+			head = (head + 1) & mask;
+			--validLen;
+		}
+
+		size_t size() const
+		{
+			return validLen;
+		}
+
+		bool empty() const
+		{
+			return validLen == 0;
+		}
+
+		//number of elements that can be held without growing
+		size_t capacity() const
+		{
+			return start ? mask + 1 : 0;
+		}
+
+		//destroy all the elements but keep the buffer
+		void clear()
+		{
+			for (size_t i = 0; i < validLen; i++)
+				slot(i)->~T();
+
+			head = validLen = 0;
+		}
+	};
+}
+
+#endif
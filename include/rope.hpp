@@ -0,0 +1,1040 @@
+#ifndef SJTU_ROPE_HPP
+#define SJTU_ROPE_HPP
+
+#include "exceptions.hpp"
+
+#include <cstdlib>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+#include <type_traits>
+#include <atomic>
+
+namespace sjtu
+{
+//A sequence container for huge middle-insert workloads, based on an implicit treap.
+//Every treap node owns a chunk of consecutive elements and the nodes are ordered by position,
+//so insert/erase of a range, split, concat and index access take O(log(n)) expected time,
+//while the elements moved by a single insert or erase are bounded by the chunk length.
+//The interface is compatible with deque. Any insert, erase, split or concat invalidates the iterators.
+template<class T>
+class rope
+{
+private:
+	//each chunk holds the elements in about 512 bytes, but at least 8 of them
+	static const size_t chunkLen = sizeof(T) * 8 < 512 ? 512 / sizeof(T) : 8;
+
+	class node
+	{
+		friend class rope<T>;
+
+	private:
+		node *lch, *rch;
+		unsigned long long priority;
+		size_t size;//number of elements in the subtree
+		size_t nodeCnt;//number of nodes in the subtree
+		T *start;//chunkLen slots
+		size_t head, len;//the elements lie in [start+head, start+head+len)
+
+	public:
+		node(unsigned long long _priority) :
+			lch(nullptr),
+			rch(nullptr),
+			priority(_priority),
+			size(0),
+			nodeCnt(1),
+			start((T *)std::malloc(chunkLen * sizeof(T))),
+			head(0),
+			len(0)
+		{}
+
+		node(const node &rhs) = delete;
+
+		node& operator=(const node &rhs) = delete;
+
+		~node()
+		{
+			for (size_t i = 0; i < len; i++)
+				(start + head + i)->~T();
+
+			std::free(start);
+		}
+
+		T* left() const
+		{
+			return start + head;
+		}
+
+		size_t backRoom() const
+		{
+			return chunkLen - head - len;
+		}
+
+		void update()
+		{
+			size = len;
+			nodeCnt = 1;
+			if (lch)
+			{
+				size += lch->size;
+				nodeCnt += lch->nodeCnt;
+			}
+			if (rch)
+			{
+				size += rch->size;
+				nodeCnt += rch->nodeCnt;
+			}
+		}
+
+		//insert value before the offset-th element, shifting the shorter side. The chunk must not be full,
+		//and value must not be one of its elements, as they are moved before value is taken
+		void insert(size_t offset, T &&value)
+		{
+			if (head > 0 && (2 * offset < len || backRoom() == 0))
+			{
+				transfer(left() - 1, left(), offset);
+				--head;
+			}
+			else
+				transfer(left() + offset + 1, left() + offset, len - offset);
+
+			new (left() + offset) T(std::move(value));
+			++len;
+		}
+
+		//erase the offset-th element, shifting the shorter side
+		void erase(size_t offset)
+		{
+			(left() + offset)->~T();
+			if (2 * offset < len)
+			{
+				transfer(left() + 1, left(), offset);
+				++head;
+			}
+			else
+				transfer(left() + offset, left() + offset + 1, len - offset - 1);
+
+			--len;
+		}
+
+		//move cnt elements from src to dst and destroy the original ones, the ranges may overlap.
+		//trivially copyable types are relocated by memmove, others are move constructed one by one.
+		static void transfer(T *dst, T *src, size_t cnt)
+		{
+			if (dst == src || cnt == 0)
+				return;
+
+			transfer(dst, src, cnt, std::integral_constant<bool, std::is_trivially_copyable<T>::value>());
+		}
+
+		static void transfer(T *dst, T *src, size_t cnt, std::true_type)
+		{
+			std::memmove((void *)dst, (const void *)src, cnt * sizeof(T));
+		}
+
+		static void transfer(T *dst, T *src, size_t cnt, std::false_type)
+		{
+			if (dst < src)
+			{
+				for (size_t i = 0; i < cnt; i++)
+				{
+					new (dst + i) T(std::move(*(src + i)));
+					(src + i)->~T();
+				}
+			}
+			else
+			{
+				for (size_t i = cnt; i > 0; i--)
+				{
+					new (dst + i - 1) T(std::move(*(src + i - 1)));
+					(src + i - 1)->~T();
+				}
+			}
+		}
+	};
+
+	node *root;
+	unsigned long long seed;//state of the xorshift generator for priorities
+
+	void exchange(rope &rhs)
+	{
+		std::swap(root, rhs.root);
+		std::swap(seed, rhs.seed);
+	}
+
+	//every rope gets a different seed, so that the priorities of two ropes are independent after concat
+	static unsigned long long nextSeed()
+	{
+		static std::atomic<unsigned long long> s(0);
+		return s.fetch_add(0x9E3779B97F4A7C15ULL, std::memory_order_relaxed) + 0x9E3779B97F4A7C15ULL;
+	}
+
+	unsigned long long randomPriority()
+	{
+		seed ^= seed << 13;
+		seed ^= seed >> 7;
+		seed ^= seed << 17;
+		return seed;
+	}
+
+	static size_t sizeOf(const node *t)
+	{
+		return t ? t->size : 0;
+	}
+
+	//split t into the first k elements and the rest, the chunk across the border is cut in two
+	void splitTree(node *t, size_t k, node *&l, node *&r)
+	{
+		if (!t)
+		{
+			l = r = nullptr;
+			return;
+		}
+
+		const size_t ls = sizeOf(t->lch);
+		if (k <= ls)
+		{
+			splitTree(t->lch, k, l, t->lch);
+			r = t;
+		}
+		else if (k >= ls + t->len)
+		{
+			splitTree(t->rch, k - ls - t->len, t->rch, r);
+			l = t;
+		}
+		else
+		{
+			const size_t offset = k - ls;
+			node *q = new node(randomPriority());
+			q->len = t->len - offset;
+			node::transfer(q->start, t->left() + offset, q->len);
+			t->len = offset;
+			q->update();
+
+			r = mergeTree(q, t->rch);
+			t->rch = nullptr;
+			l = t;
+		}
+		t->update();
+	}
+
+	static node* mergeTree(node *a, node *b)
+	{
+		if (!a)
+			return b;
+		if (!b)
+			return a;
+
+		if (a->priority > b->priority)
+		{
+			a->rch = mergeTree(a->rch, b);
+			a->update();
+			return a;
+		}
+		else
+		{
+			b->lch = mergeTree(a, b->lch);
+			b->update();
+			return b;
+		}
+	}
+
+	//build a treap from the nodes in sequence in O(m), with a stack holding the right spine
+	static node* build(node **nodes, size_t m)
+	{
+		if (m == 0)
+			return nullptr;
+
+		node **spine = (node **)std::malloc(m * sizeof(node *));
+		size_t top = 0;
+		for (size_t i = 0; i < m; i++)
+		{
+			node *x = nodes[i], *prev = nullptr;
+			while (top > 0 && spine[top - 1]->priority < x->priority)
+			{
+				prev = spine[--top];
+				prev->update();
+			}
+
+			x->lch = prev;
+			x->rch = nullptr;
+			if (top > 0)
+				spine[top - 1]->rch = x;
+			spine[top++] = x;
+		}
+		while (top > 0)
+			spine[--top]->update();
+
+		node *ans = spine[0];
+		std::free(spine);
+		return ans;
+	}
+
+	//put the elements of [first, last) into full chunks and build a treap of them
+	template<class InputIt>
+	node* assemble(InputIt first, InputIt last)
+	{
+		node **nodes = nullptr, *cur = nullptr;
+		size_t m = 0, cap = 0;
+		for (; first != last; ++first)
+		{
+			if (!cur || cur->len == chunkLen)
+			{
+				if (m == cap)
+				{
+					cap = cap == 0 ? 4 : 2 * cap;
+					nodes = (node **)std::realloc(nodes, cap * sizeof(node *));
+				}
+				cur = nodes[m++] = new node(randomPriority());
+			}
+			new (cur->start + cur->len) T(*first);
+			++cur->len;
+		}
+
+		node *ans = build(nodes, m);
+		std::free(nodes);
+		return ans;
+	}
+
+	node* clone(const node *t)
+	{
+		if (!t)
+			return nullptr;
+
+		node *q = new node(t->priority);
+		q->head = t->head;
+		for (size_t i = 0; i < t->len; i++)
+			new (q->left() + i) T(*(t->left() + i));
+		q->len = t->len;
+		q->lch = clone(t->lch);
+		q->rch = clone(t->rch);
+		q->update();
+		return q;
+	}
+
+	static void destroy(node *t)
+	{
+		if (!t)
+			return;
+
+		destroy(t->lch);
+		destroy(t->rch);
+		delete t;
+	}
+
+	static void collect(node *t, node **out, size_t &cnt)
+	{
+		if (!t)
+			return;
+
+		collect(t->lch, out, cnt);
+		out[cnt++] = t;
+		collect(t->rch, out, cnt);
+	}
+
+	//the node holding the pos-th element, as well as the index of its first element
+	node* locate(size_t pos, size_t &begin) const
+	{
+		node *t = root;
+		begin = 0;
+		while (t)
+		{
+			const size_t ls = sizeOf(t->lch);
+			if (pos < ls)
+				t = t->lch;
+			else if (pos < ls + t->len)
+			{
+				begin += ls;
+				return t;
+			}
+			else
+			{
+				pos -= ls + t->len;
+				begin += ls + t->len;
+				t = t->rch;
+			}
+		}
+		return nullptr;
+	}
+
+	//add delta to the sizes along the path from root to the node holding the pos-th element
+	void resize(size_t pos, int delta)
+	{
+		node *t = root;
+		while (t)
+		{
+			t->size += delta;
+			const size_t ls = sizeOf(t->lch);
+			if (pos < ls)
+				t = t->lch;
+			else if (pos < ls + t->len)
+				return;
+			else
+			{
+				pos -= ls + t->len;
+				t = t->rch;
+			}
+		}
+	}
+
+	//put the standalone node q before the pos-th element
+	void insertNode(size_t pos, node *q)
+	{
+		node *l, *r;
+		q->update();
+		splitTree(root, pos, l, r);
+		root = mergeTree(mergeTree(l, q), r);
+	}
+
+	//value is taken by copy, so it may be an element of this rope, which is moved about before value is put in
+	void insertValue(size_t pos, T value)
+	{
+		if (!root)
+		{
+			node *q = new node(randomPriority());
+			q->head = chunkLen / 2;
+			new (q->left()) T(std::move(value));
+			q->len = 1;
+			q->update();
+			root = q;
+			return;
+		}
+
+		//find the chunk to put value in, prefer the end of the previous chunk if it has room
+		size_t begin = 0;
+		node *t = nullptr;
+		if (pos < size())
+			t = locate(pos, begin);
+		if (!t || (pos == begin && pos > 0))
+		{
+			size_t prevBegin = 0;
+			node *p = locate(pos - 1, prevBegin);
+			if (!t || p->len < chunkLen)
+			{
+				t = p;
+				begin = prevBegin;
+			}
+		}
+
+		const size_t offset = pos - begin;
+		if (t->len < chunkLen)
+		{
+			t->insert(offset, std::move(value));
+			resize(begin, 1);
+		}
+		else if (offset == 0 || offset == t->len)
+		{
+			//a full chunk at the border, e.g. push_back or push_front: start a new chunk
+			node *q = new node(randomPriority());
+			q->head = offset == 0 ? chunkLen - 1 : 0;
+			new (q->left()) T(std::move(value));
+			q->len = 1;
+			insertNode(pos, q);
+		}
+		else
+		{
+			//cut the full chunk in half, then there's room on both sides
+			node *l, *r;
+			splitTree(root, begin + t->len / 2, l, r);
+			root = mergeTree(l, r);
+			insertValue(pos, std::move(value));
+			return;
+		}
+		rebalance();
+	}
+
+	void eraseValue(size_t pos)
+	{
+		size_t begin = 0;
+		node *t = locate(pos, begin);
+		if (t->len == 1)
+		{
+			node *l, *m, *r;
+			splitTree(root, pos, l, m);
+			splitTree(m, 1, m, r);
+			delete m;
+			root = mergeTree(l, r);
+		}
+		else
+		{
+			t->erase(pos - begin);
+			resize(begin, -1);
+		}
+		rebalance();
+	}
+
+	//too many sparse chunks after erase and split: move the elements into full chunks and rebuild the treap
+	void rebalance()
+	{
+		if (root && root->nodeCnt > 4 * (root->size / chunkLen) + 8)
+			compact();
+	}
+
+	void compact()
+	{
+		size_t m = 0, k = 0;
+		node **old = (node **)std::malloc(root->nodeCnt * sizeof(node *));
+		node **fresh = (node **)std::malloc((root->size / chunkLen + 1) * sizeof(node *));
+		collect(root, old, m);
+
+		node *cur = nullptr;
+		for (size_t i = 0; i < m; i++)
+		{
+			node *p = old[i];
+			size_t moved = 0;
+			while (moved < p->len)
+			{
+				if (!cur || cur->len == chunkLen)
+					cur = fresh[k++] = new node(randomPriority());
+
+				size_t cnt = chunkLen - cur->len;
+				if (cnt > p->len - moved)
+					cnt = p->len - moved;
+				node::transfer(cur->start + cur->len, p->left() + moved, cnt);
+				cur->len += cnt;
+				moved += cnt;
+			}
+			p->len = 0;//the elements have been moved out
+			delete p;
+		}
+
+		root = build(fresh, k);
+		std::free(old);
+		std::free(fresh);
+	}
+
+public:
+	class const_iterator;
+	class iterator
+	{
+		friend class const_iterator;
+		friend class rope<T>;
+
+	private:
+		rope<T> *ascription;
+		size_t index;
+		node *leaf;//the chunk holding the index-th element, nullptr for end()
+		size_t leafBegin;//index of the first element in leaf
+
+		void seek()
+		{
+			if (index < ascription->size())
+				leaf = ascription->locate(index, leafBegin);
+			else
+				leaf = nullptr;
+		}
+
+	public:
+		//constructor
+		iterator(rope<T> *_a = nullptr, size_t _index = 0) :
+			ascription(_a),
+			index(_index),
+			leaf(nullptr),
+			leafBegin(0)
+		{
+			if (ascription)
+				seek();
+		}
+
+		iterator(const iterator &rhs) :
+			ascription(rhs.ascription),
+			index(rhs.index),
+			leaf(rhs.leaf),
+			leafBegin(rhs.leafBegin)
+		{}
+
+		// return the distance between two iterator,
+		// if these two iterators point to different rope, throw invaild_iterator.
+		int operator-(const iterator &rhs) const
+		{
+			if (ascription != rhs.ascription)
+				throw invalid_iterator();
+
+			return (int)index - (int)rhs.index;
+		}
+
+		iterator operator+(int n) const
+		{
+			iterator tmp(*this);
+			return tmp += n;
+		}
+
+		iterator operator-(int n) const
+		{
+			iterator tmp(*this);
+			return tmp -= n;
+		}
+
+		//moving inside the cached chunk is O(1), otherwise the chunk is located in O(log(n))
+		iterator& operator+=(int n)
+		{
+			if (n < 0)
+				return operator-=(-n);
+
+			if (index + n > ascription->size())
+				throw invalid_iterator();
+
+			index += n;
+			if (!leaf || index >= leafBegin + leaf->len)
+				seek();
+			return *this;
+		}
+
+		iterator& operator-=(int n)
+		{
+			if (n < 0)
+				return operator+=(-n);
+
+			if ((size_t)n > index)
+				throw invalid_iterator();
+
+			index -= n;
+			if (!leaf || index < leafBegin)
+				seek();
+			return *this;
+		}
+
+		iterator operator++(int)
+		{
+			iterator tmp(*this);
+			++*this;
+			return tmp;
+		}
+
+		iterator& operator++()
+		{
+			return operator+=(1);
+		}
+
+		iterator operator--(int)
+		{
+			iterator tmp(*this);
+			--*this;
+			return tmp;
+		}
+
+		iterator& operator--()
+		{
+			return operator-=(1);
+		}
+
+		T& operator*() const
+		{
+			if (!leaf)
+				throw invalid_iterator();
+
+			return *(leaf->left() + (index - leafBegin));
+		}
+
+		T* operator->() const
+		{
+			return &(operator*());
+		}
+
+		bool operator==(const iterator &rhs) const
+		{
+			return ascription && ascription == rhs.ascription && index == rhs.index;
+		}
+
+		bool operator==(const const_iterator &rhs) const
+		{
+			return ascription && ascription == rhs.ascription && index == rhs.index;
+		}
+
+		bool operator!=(const iterator &rhs) const
+		{
+			return !operator==(rhs);
+		}
+
+		bool operator!=(const const_iterator &rhs) const
+		{
+			return !operator==(rhs);
+		}
+
+		//check if the iterator belongs to the given rope and points to an element or end()
+		bool isValid(void *id) const
+		{
+			return id && id == ascription && index <= ascription->size();
+		}
+	};
+
+	class const_iterator
+	{
+		friend class iterator;
+		friend class rope<T>;
+
+	private:
+		const rope<T> *ascription;
+		size_t index;
+		const node *leaf;
+		size_t leafBegin;
+
+		void seek()
+		{
+			if (index < ascription->size())
+				leaf = ascription->locate(index, leafBegin);
+			else
+				leaf = nullptr;
+		}
+
+	public:
+		//constructor
+		const_iterator(const rope<T> *_a = nullptr, size_t _index = 0) :
+			ascription(_a),
+			index(_index),
+			leaf(nullptr),
+			leafBegin(0)
+		{
+			if (ascription)
+				seek();
+		}
+
+		const_iterator(const iterator &rhs) :
+			ascription(rhs.ascription),
+			index(rhs.index),
+			leaf(rhs.leaf),
+			leafBegin(rhs.leafBegin)
+		{}
+
+		const_iterator(const const_iterator &rhs) :
+			ascription(rhs.ascription),
+			index(rhs.index),
+			leaf(rhs.leaf),
+			leafBegin(rhs.leafBegin)
+		{}
+
+		// return the distance between two iterator,
+		// if these two iterators point to different rope, throw invaild_iterator.
+		int operator-(const const_iterator &rhs) const
+		{
+			if (ascription != rhs.ascription)
+				throw invalid_iterator();
+
+			return (int)index - (int)rhs.index;
+		}
+
+		const_iterator operator+(int n) const
+		{
+			const_iterator tmp(*this);
+			return tmp += n;
+		}
+
+		const_iterator operator-(int n) const
+		{
+			const_iterator tmp(*this);
+			return tmp -= n;
+		}
+
+		const_iterator& operator+=(int n)
+		{
+			if (n < 0)
+				return operator-=(-n);
+
+			if (index + n > ascription->size())
+				throw invalid_iterator();
+
+			index += n;
+			if (!leaf || index >= leafBegin + leaf->len)
+				seek();
+			return *this;
+		}
+
+		const_iterator& operator-=(int n)
+		{
+			if (n < 0)
+				return operator+=(-n);
+
+			if ((size_t)n > index)
+				throw invalid_iterator();
+
+			index -= n;
+			if (!leaf || index < leafBegin)
+				seek();
+			return *this;
+		}
+
+		const_iterator operator++(int)
+		{
+			const_iterator tmp(*this);
+			++*this;
+			return tmp;
+		}
+
+		const_iterator& operator++()
+		{
+			return operator+=(1);
+		}
+
+		const_iterator operator--(int)
+		{
+			const_iterator tmp(*this);
+			--*this;
+			return tmp;
+		}
+
+		const_iterator& operator--()
+		{
+			return operator-=(1);
+		}
+
+		const T& operator*() const
+		{
+			if (!leaf)
+				throw invalid_iterator();
+
+			return *(leaf->left() + (index - leafBegin));
+		}
+
+		const T* operator->() const
+		{
+			return &(operator*());
+		}
+
+		bool operator==(const iterator &rhs) const
+		{
+			return ascription && ascription == rhs.ascription && index == rhs.index;
+		}
+
+		bool operator==(const const_iterator &rhs) const
+		{
+			return ascription && ascription == rhs.ascription && index == rhs.index;
+		}
+
+		bool operator!=(const iterator &rhs) const
+		{
+			return !operator==(rhs);
+		}
+
+		bool operator!=(const const_iterator &rhs) const
+		{
+			return !operator==(rhs);
+		}
+
+		bool isValid(const void *id) const
+		{
+			return id && id == ascription && index <= ascription->size();
+		}
+	};
+
+	rope() :
+		root(nullptr),
+		seed(nextSeed())
+	{}
+
+	template<class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+	rope(InputIt first, InputIt last) :
+		root(nullptr),
+		seed(nextSeed())
+	{
+		root = assemble(first, last);
+	}
+
+	rope(const rope &rhs) :
+		root(nullptr),
+		seed(nextSeed())
+	{
+		root = clone(rhs.root);
+	}
+
+	~rope()
+	{
+		clear();
+	}
+
+	rope& operator=(rope other)
+	{
+		exchange(other);
+		return *this;
+	}
+
+	//access specified element with bounds checking
+	T& at(size_t pos)
+	{
+		if (pos >= size())
+			throw index_out_of_bound();
+
+		size_t begin = 0;
+		node *t = locate(pos, begin);
+		return *(t->left() + (pos - begin));
+	}
+
+	const T& at(size_t pos) const
+	{
+		if (pos >= size())
+			throw index_out_of_bound();
+
+		size_t begin = 0;
+		const node *t = locate(pos, begin);
+		return *(t->left() + (pos - begin));
+	}
+
+	T& operator[](const size_t &pos)
+	{
+		return at(pos);
+	}
+
+	const T& operator[](const size_t &pos) const
+	{
+		return at(pos);
+	}
+
+	//access the first element
+	const T& front() const
+	{
+		if (empty())
+			throw container_is_empty();
+
+		return at(0);
+	}
+
+	//access the last element
+	const T& back() const
+	{
+		if (empty())
+			throw container_is_empty();
+
+		return at(size() - 1);
+	}
+
+	iterator begin()
+	{
+		return iterator(this, 0);
+	}
+
+	const_iterator cbegin() const
+	{
+		return const_iterator(this, 0);
+	}
+
+	iterator end()
+	{
+		return iterator(this, size());
+	}
+
+	const_iterator cend() const
+	{
+		return const_iterator(this, size());
+	}
+
+	bool empty() const
+	{
+		return size() == 0;
+	}
+
+	size_t size() const
+	{
+		return sizeOf(root);
+	}
+
+	void clear()
+	{
+		destroy(root);
+		root = nullptr;
+	}
+
+	//inserts value before pos, return the iterator to the inserted value
+	iterator insert(iterator pos, const T &value)
+	{
+		if (!pos.isValid(this))
+			throw invalid_iterator();
+
+		insertValue(pos.index, value);
+		return iterator(this, pos.index);
+	}
+
+	//inserts the elements of [first, last) before pos, return the iterator to the first inserted one
+	template<class InputIt, class = typename std::enable_if<!std::is_integral<InputIt>::value>::type>
+	iterator insert(iterator pos, InputIt first, InputIt last)
+	{
+		if (!pos.isValid(this))
+			throw invalid_iterator();
+
+		node *l, *r;
+		splitTree(root, pos.index, l, r);
+		root = mergeTree(mergeTree(l, assemble(first, last)), r);
+		rebalance();
+		return iterator(this, pos.index);
+	}
+
+	//removes the element at pos, return the iterator following it
+	iterator erase(iterator pos)
+	{
+		if (empty() || !pos.isValid(this) || pos.index == size())
+			throw invalid_iterator();
+
+		eraseValue(pos.index);
+		return iterator(this, pos.index);
+	}
+
+	//removes the elements in [first, last), return the iterator following the last removed one
+	iterator erase(iterator first, iterator last)
+	{
+		if (!first.isValid(this) || !last.isValid(this) || first.index > last.index)
+			throw invalid_iterator();
+
+		node *l, *m, *r;
+		splitTree(root, first.index, l, m);
+		splitTree(m, last.index - first.index, m, r);
+		destroy(m);
+		root = mergeTree(l, r);
+		rebalance();
+		return iterator(this, first.index);
+	}
+
+	void push_back(const T &value)
+	{
+		insertValue(size(), value);
+	}
+
+	void pop_back()
+	{
+		if (empty())
+			throw container_is_empty();
+
+		eraseValue(size() - 1);
+	}
+
+	void push_front(const T &value)
+	{
+		insertValue(0, value);
+	}
+
+	void pop_front()
+	{
+		if (empty())
+			throw container_is_empty();
+
+		eraseValue(0);
+	}
+
+	//keep the first pos elements, and return the rest as a new rope
+	rope split(size_t pos)
+	{
+		if (pos > size())
+			throw index_out_of_bound();
+
+		rope ans;
+		splitTree(root, pos, root, ans.root);
+		rebalance();
+		ans.rebalance();
+		return ans;
+	}
+
+	//append all the elements of rhs, which becomes empty
+	void concat(rope &rhs)
+	{
+		if (&rhs == this)
+		{
+			rope tmp(rhs);
+			concat(tmp);
+			return;
+		}
+
+		root = mergeTree(root, rhs.root);
+		rhs.root = nullptr;
+	}
+};
+
+}
+
+#endif
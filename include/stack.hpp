@@ -7,6 +7,7 @@
 
 #include <cstdlib>
 #include <algorithm>
+#include <utility>
 
 namespace sjtu 
 {
@@ -21,7 +22,8 @@ class stack
 {
 private:
 
-	ListType *container;
+	//held by value, so that creating a stack costs no extra allocation and an access no extra indirection
+	ListType container;
 
 	void swap(stack &rhs) 
 	{ 
@@ -29,23 +31,16 @@ private:
 	}
 
 public:
-	stack() 
-	{
-		container = (ListType*)malloc(sizeof(ListType));
-		new (container) ListType();
-	}
+	stack() {}
 
-	stack(const stack &other) 
-	{
-		container = (ListType*)malloc(sizeof(ListType));
-		new (container) ListType(*(other.container));
-	}
+	stack(const stack &other) :
+		container(other.container)
+	{}
 
-	~stack()
-	{
-		container->~ListType();
-		free(container);
-	}
+	//take over the elements of other, which is left empty
+	stack(stack &&other) :
+		container(std::move(other.container))
+	{}
 
 	stack &operator=(stack other) 
 	{
@@ -63,7 +58,7 @@ public:
 		if (empty())
 			throw container_is_empty();
 
-		return container->back(); 
+		return container.back(); 
 	}
 
 	/**
@@ -71,7 +66,31 @@ public:
 	 */
 	void push(const T &e) 
 	{ 
-		container->push_back(e); 
+		container.push_back(e); 
+	}
+
+	void push(T &&e)
+	{
+		container.push_back(std::move(e));
+	}
+
+	/**
+	 * construct a new element on the top from args.
+	 */
+	template<typename... Args>
+	void emplace(Args&&... args)
+	{
+		container.emplace_back(std::forward<Args>(args)...);
+	}
+
+	/**
+	 * push the elements in [first, last) one by one, so *(last - 1) ends up on the top.
+	 */
+	template<typename InputIt>
+	void push_bulk(InputIt first, InputIt last)
+	{
+		for (; first != last; ++first)
+			container.push_back(*first);
 	}
 	
 	/**
@@ -83,7 +102,23 @@ public:
 		if (empty())
 			throw container_is_empty();
 
-		container->pop_back(); 
+		container.pop_back(); 
+	}
+
+	/**
+	 * pop at most max elements from the top and move them to out, the top one first.
+	 * @return the number of popped elements.
+	 */
+	template<typename OutputIt>
+	size_t pop_bulk(OutputIt out, size_t max)
+	{
+		size_t cnt = 0;
+		for (; cnt < max && !container.empty(); ++cnt, ++out)
+		{
+			*out = std::move(container.back());
+			container.pop_back();
+		}
+		return cnt;
 	}
 
 	/**
@@ -91,7 +126,7 @@ public:
 	 */
 	size_t size() const 
 	{ 
-		return container->size(); 
+		return container.size(); 
 	}
 
 	/**
@@ -100,7 +135,7 @@ public:
 	 */
 	bool empty() const 
 	{ 
-		return container->empty();
+		return container.empty();
 	}
 };
 
@@ -0,0 +1,471 @@
+#ifndef SJTU_THREAD_POOL_HPP
+#define SJTU_THREAD_POOL_HPP
+
+#include "queue.hpp"
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <atomic>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <type_traits>
+#include <utility>
+
+namespace sjtu
+{
+	//the Chase-Lev deque: the owner thread pushes and pops at the bottom without any CAS,
+	//while the other threads steal from the top. Only the thieves and the owner taking the last element
+	//compete, by a CAS on top. The circular array is doubled when it's full, and the old arrays are kept
+	//until the deque is destroyed, as a thief may still be reading them.
+	//T should be trivially copyable, such as a pointer.
+	template<typename T>
+	class work_stealing_deque
+	{
+	private:
+		struct array
+		{
+			size_t mask;//capacity - 1
+			std::atomic<T> *cells;
+			array *prev;//the smaller array replaced by this one
+
+			array(size_t capacity, array *p) :
+				mask(capacity - 1),
+				prev(p)
+			{
+				cells = (std::atomic<T> *)std::malloc(capacity * sizeof(std::atomic<T>));
+				for (size_t i = 0; i < capacity; i++)
+					new (cells + i) std::atomic<T>();
+			}
+
+			~array()
+			{
+				std::free(cells);
+			}
+
+			T get(long long i) const
+			{
+				return cells[i & mask].load(std::memory_order_relaxed);
+			}
+
+			void put(long long i, const T &value)
+			{
+				cells[i & mask].store(value, std::memory_order_relaxed);
+			}
+		};
+
+		//top <= bottom, the elements are in [top, bottom)
+		std::atomic<long long> top;
+		char pad[64];//keep the index of the thieves away from that of the owner
+		std::atomic<long long> bottom;
+		std::atomic<array *> buffer;
+
+		array* grow(array *a, long long t, long long b)
+		{
+			array *bigger = new array(2 * (a->mask + 1), a);
+			for (long long i = t; i < b; i++)
+				bigger->put(i, a->get(i));
+
+			buffer.store(bigger, std::memory_order_release);
+			return bigger;
+		}
+
+	public:
+		explicit work_stealing_deque(size_t capacity = 64) :
+			top(0),
+			bottom(0)
+		{
+			size_t cap = 2;
+			while (cap < capacity)
+				cap *= 2;
+			buffer.store(new array(cap, nullptr), std::memory_order_relaxed);
+		}
+
+		work_stealing_deque(const work_stealing_deque &) = delete;
+		work_stealing_deque& operator=(const work_stealing_deque &) = delete;
+
+		~work_stealing_deque()
+		{
+			array *a = buffer.load(std::memory_order_relaxed);
+			while (a)
+			{
+				array *p = a->prev;
+				delete a;
+				a = p;
+			}
+		}
+
+		//owner only
+		void push(const T &value)
+		{
+			const long long b = bottom.load(std::memory_order_relaxed);
+			const long long t = top.load(std::memory_order_acquire);
+			array *a = buffer.load(std::memory_order_relaxed);
+			if (b - t > (long long)a->mask)
+				a = grow(a, t, b);
+
+			a->put(b, value);
+			bottom.store(b + 1, std::memory_order_release);
+		}
+
+		//owner only, take the element pushed last. return false if the deque is empty
+		bool pop(T &out)
+		{
+			const long long b = bottom.load(std::memory_order_relaxed) - 1;
+			array *a = buffer.load(std::memory_order_relaxed);
+			//reserve the bottom element before looking at top, so that a thief can't take it unnoticed
+			bottom.store(b, std::memory_order_seq_cst);
+			long long t = top.load(std::memory_order_seq_cst);
+
+			if (t > b)
+			{
+				bottom.store(b + 1, std::memory_order_relaxed);
+				return false;
+			}
+
+			out = a->get(b);
+			if (t < b)
+				return true;
+
+			//the last element, race the thieves for it
+			const bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return won;
+		}
+
+		//any thread, take the element pushed first. return false if the deque is empty or another thread won
+		bool steal(T &out)
+		{
+			long long t = top.load(std::memory_order_seq_cst);
+			const long long b = bottom.load(std::memory_order_seq_cst);
+			if (t >= b)
+				return false;
+
+			array *a = buffer.load(std::memory_order_acquire);
+			out = a->get(t);
+			return top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+		}
+
+		//only a snapshot when other threads are working on the deque
+		size_t size_approx() const
+		{
+			const long long b = bottom.load(std::memory_order_relaxed);
+			const long long t = top.load(std::memory_order_relaxed);
+			return b > t ? b - t : 0;
+		}
+
+		bool empty() const
+		{
+			return size_approx() == 0;
+		}
+	};
+
+	//a fork/join scheduler. Each worker owns a work_stealing_deque of jobs: it runs its own jobs newest first
+	//and steals the oldest jobs of the others when it runs out, so the big halves of a split range get stolen
+	//and the small ones stay local. A thread waiting for a forked job keeps running other jobs meanwhile,
+	//hence parallel_invoke and parallel_for can be nested freely. Idle workers sleep on a condition variable.
+	class thread_pool
+	{
+	private:
+		//a forked call, living on the stack of the thread which waits for it
+		struct job
+		{
+			void (*call)(void *);
+			void *arg;
+			std::atomic<bool> done;
+			std::exception_ptr error;
+
+			job(void (*c)(void *), void *a) :
+				call(c),
+				arg(a),
+				done(false)
+			{}
+
+			void run()
+			{
+				try
+				{
+					call(arg);
+				}
+				catch (...)
+				{
+					error = std::current_exception();
+				}
+				done.store(true, std::memory_order_release);
+			}
+		};
+
+		template<typename F>
+		static void invoke(void *f)
+		{
+			(*static_cast<F *>(f))();
+		}
+
+		//which pool the current thread works for and its index there
+		struct worker_id
+		{
+			thread_pool *pool;
+			size_t index;
+		};
+
+		static worker_id& self()
+		{
+			static thread_local worker_id id = { nullptr, 0 };
+			return id;
+		}
+
+		static const size_t spinLimit = 64;
+
+		size_t workerCnt;
+		work_stealing_deque<job *> *deques;
+		std::thread *workers;
+
+		//jobs forked by threads outside the pool
+		queue<job *> injected;
+		std::atomic<size_t> injectedCnt;//size of injected, so that it is not locked when empty
+		std::mutex injectMutex;
+
+		std::atomic<size_t> pendingCnt;//jobs pushed but not taken yet
+		std::atomic<size_t> sleeperCnt;
+		std::atomic<bool> stopping;
+		std::mutex idleMutex;
+		std::condition_variable idle;
+
+		void submit(job *j)
+		{
+			//counted before it's visible, so that the count never drops below zero
+			pendingCnt.fetch_add(1, std::memory_order_seq_cst);
+
+			worker_id &id = self();
+			if (id.pool == this)
+				deques[id.index].push(j);
+			else
+			{
+				std::lock_guard<std::mutex> lock(injectMutex);
+				injected.push(j);
+				injectedCnt.store(injected.size(), std::memory_order_relaxed);
+			}
+
+			if (sleeperCnt.load(std::memory_order_seq_cst) > 0)
+			{
+				std::lock_guard<std::mutex> lock(idleMutex);
+				idle.notify_one();
+			}
+		}
+
+		//take a job from the own deque, the injected ones or any other worker. return nullptr if there's none
+		job* findJob()
+		{
+			worker_id &id = self();
+			const bool inside = id.pool == this;
+			job *j = nullptr;
+
+			if (inside && deques[id.index].pop(j))
+			{
+				pendingCnt.fetch_sub(1, std::memory_order_relaxed);
+				return j;
+			}
+
+			if (injectedCnt.load(std::memory_order_relaxed) > 0)
+			{
+				std::lock_guard<std::mutex> lock(injectMutex);
+				if (!injected.empty())
+				{
+					j = injected.front();
+					injected.pop();
+					injectedCnt.store(injected.size(), std::memory_order_relaxed);
+					pendingCnt.fetch_sub(1, std::memory_order_relaxed);
+					return j;
+				}
+			}
+
+			const size_t first = inside ? id.index + 1 : 0;
+			for (size_t k = 0; k < workerCnt; k++)
+			{
+				const size_t victim = (first + k) % workerCnt;
+				if (inside && victim == id.index)
+					continue;
+				if (deques[victim].steal(j))
+				{
+					pendingCnt.fetch_sub(1, std::memory_order_relaxed);
+					return j;
+				}
+			}
+			return nullptr;
+		}
+
+		void workerLoop(size_t index)
+		{
+			self().pool = this;
+			self().index = index;
+
+			size_t misses = 0;
+			while (!stopping.load(std::memory_order_relaxed))
+			{
+				job *j = findJob();
+				if (j)
+				{
+					j->run();
+					misses = 0;
+					continue;
+				}
+
+				//new jobs often come soon, so look again a few times before going to sleep
+				if (++misses < spinLimit)
+				{
+					std::this_thread::yield();
+					continue;
+				}
+				misses = 0;
+
+				std::unique_lock<std::mutex> lock(idleMutex);
+				sleeperCnt.fetch_add(1, std::memory_order_seq_cst);
+				idle.wait(lock, [this]() {
+					return pendingCnt.load(std::memory_order_seq_cst) > 0 || stopping.load(std::memory_order_relaxed);
+				});
+				sleeperCnt.fetch_sub(1, std::memory_order_relaxed);
+			}
+		}
+
+		//run other jobs until j is done, then rethrow what j threw
+		void join(job &j)
+		{
+			while (!j.done.load(std::memory_order_acquire))
+			{
+				job *other = findJob();
+				if (other)
+					other->run();
+				else
+					std::this_thread::yield();
+			}
+
+			if (j.error)
+				std::rethrow_exception(j.error);
+		}
+
+		template<typename Index, typename F>
+		void forRange(Index first, Index last, Index grain, const F &f)
+		{
+			while (last - first > grain)
+			{
+				//fork the right half and go on with the left one
+				const Index mid = first + (last - first) / 2;
+				auto right = [this, mid, last, grain, &f]() { forRange(mid, last, grain, f); };
+				job j(&invoke<decltype(right)>, &right);
+				submit(&j);
+
+				std::exception_ptr error;
+				try
+				{
+					forRange(first, mid, grain, f);
+				}
+				catch (...)
+				{
+					error = std::current_exception();
+				}
+				join(j);
+				if (error)
+					std::rethrow_exception(error);
+				return;
+			}
+
+			for (; first < last; ++first)
+				f(first);
+		}
+
+	public:
+		//the calling thread helps the workers while it waits, so threads - 1 workers would keep threads cores busy
+		explicit thread_pool(size_t threads = std::thread::hardware_concurrency()) :
+			workerCnt(threads > 0 ? threads : 1),
+			injectedCnt(0),
+			pendingCnt(0),
+			sleeperCnt(0),
+			stopping(false)
+		{
+			deques = (work_stealing_deque<job *> *)std::malloc(workerCnt * sizeof(work_stealing_deque<job *>));
+			for (size_t i = 0; i < workerCnt; i++)
+				new (deques + i) work_stealing_deque<job *>();
+
+			workers = (std::thread *)std::malloc(workerCnt * sizeof(std::thread));
+			for (size_t i = 0; i < workerCnt; i++)
+				new (workers + i) std::thread(&thread_pool::workerLoop, this, i);
+		}
+
+		thread_pool(const thread_pool &) = delete;
+		thread_pool& operator=(const thread_pool &) = delete;
+
+		//every job has been joined by then, since the callers wait for what they fork
+		~thread_pool()
+		{
+			{
+				std::lock_guard<std::mutex> lock(idleMutex);
+				stopping.store(true);
+			}
+			idle.notify_all();
+
+			for (size_t i = 0; i < workerCnt; i++)
+			{
+				workers[i].join();
+				workers[i].~thread();
+				deques[i].~work_stealing_deque<job *>();
+			}
+			std::free(workers);
+			std::free(deques);
+		}
+
+		size_t size() const
+		{
+			return workerCnt;
+		}
+
+		//run f and g in parallel and return when both are done.
+		//If any of them throws, the exception is rethrown here after both have finished
+		template<typename F, typename G>
+		void parallel_invoke(F &&f, G &&g)
+		{
+			job j(&invoke<typename std::remove_reference<G>::type>, (void *)&g);
+			submit(&j);
+
+			std::exception_ptr error;
+			try
+			{
+				f();
+			}
+			catch (...)
+			{
+				error = std::current_exception();
+			}
+			join(j);
+			if (error)
+				std::rethrow_exception(error);
+		}
+
+		template<typename F, typename G, typename H, typename... Rest>
+		void parallel_invoke(F &&f, G &&g, H &&h, Rest&&... rest)
+		{
+			parallel_invoke(std::forward<F>(f), [&]() {
+				parallel_invoke(std::forward<G>(g), std::forward<H>(h), std::forward<Rest>(rest)...);
+			});
+		}
+
+		//call f(i) for every i in [first, last). The range is split in halves down to pieces of grain indices,
+		//by default about 8 pieces for each worker
+		template<typename Index, typename F>
+		void parallel_for(Index first, Index last, const F &f, Index grain = 0)
+		{
+			if (!(first < last))
+				return;
+			if (grain <= 0)
+			{
+				grain = (last - first) / (Index)(8 * workerCnt);
+				if (grain < 1)
+					grain = 1;
+			}
+			forRange(first, last, grain, f);
+		}
+	};
+}
+
+#endif
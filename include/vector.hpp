@@ -9,6 +9,7 @@
 #include <algorithm>
 #include <cstdlib>
 #include <new>
+#include <utility>
 
 namespace sjtu
 {
@@ -44,7 +45,7 @@ namespace sjtu
 				T *data = (T*)std::malloc(newSize * sizeof(T));
 				for (auto i = 0; i < validLen; i++)
 				{
-					new (data + i) T(*(start + i));
+					new (data + i) T(std::move(*(start + i)));
 					(start + i)->~T();
 				}
 
@@ -363,6 +364,16 @@ namespace sjtu
 			}
 		}
 
+		//take over the storage of rhs, which is left empty
+		vector(vector &&rhs) :
+			start(rhs.start),
+			end_of_storage(rhs.end_of_storage),
+			validLen(rhs.validLen)
+		{
+			rhs.start = rhs.end_of_storage = nullptr;
+			rhs.validLen = 0;
+		}
+
 		vector(const std::vector<T> &rhs) :
 			start(nullptr),
 			end_of_storage(nullptr),
@@ -444,6 +455,14 @@ namespace sjtu
 			return *start;
 		}
 
+		T& front()
+		{
+			if (size() == 0)
+				throw container_is_empty();
+
+			return *start;
+		}
+
 		//access the last element
 		const T & back() const
 		{
@@ -453,6 +472,14 @@ namespace sjtu
 			return *(start + validLen - 1);
 		}
 
+		T& back()
+		{
+			if (size() == 0)
+				throw container_is_empty();
+
+			return *(start + validLen - 1);
+		}
+
 		//return an iterator to the beginning
 		//ע⣺½һvectorȡauto it=begin(),Ȼ *it=xxx,WAg++Ҳ
 		iterator begin()
@@ -580,7 +607,39 @@ namespace sjtu
 
 		void push_back(const T &value)
 		{
-			insert(end(), value);
+			emplace_back(value);
+		}
+
+		void push_back(T &&value)
+		{
+			emplace_back(std::move(value));
+		}
+
+		//construct a new element at the end from args
+		template<typename... Args>
+		void emplace_back(Args&&... args)
+		{
+			if (size() < capacity())
+			{
+				new (start + validLen) T(std::forward<Args>(args)...);
+				++validLen;
+				return;
+			}
+
+			//args may refer to an element of this vector, so the new element is built before the old ones are moved
+			const size_t newSize = capacity() == 0 ? 2 : 2 * capacity();
+			T *data = (T*)std::malloc(newSize * sizeof(T));
+			new (data + validLen) T(std::forward<Args>(args)...);
+			for (size_t i = 0; i < validLen; i++)
+			{
+				new (data + i) T(std::move(*(start + i)));
+				(start + i)->~T();
+			}
+
+			std::free(start);
+			start = data;
+			end_of_storage = start + newSize;
+			++validLen;
 		}
 
 		void pop_back()
@@ -588,7 +647,8 @@ namespace sjtu
 			if (size() == 0)
 				throw container_is_empty();
 
-			erase(--end());
+			--validLen;
+			(start + validLen)->~T();
 		}
 	};
 
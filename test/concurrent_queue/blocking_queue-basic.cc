@@ -0,0 +1,229 @@
+//Correctness test for sjtu::blocking_queue, and its speed against sjtu::queue guarded by a mutex
+//and a condition variable notified on every push.
+#include <iostream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+
+#include "../common/class-integer.hpp"
+#include "../../include/queue.hpp"
+#include "../../include/concurrent_queue.hpp"
+
+const int N = 200000;
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+double elapsed(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+//the straightforward blocking queue, which locks for every element and notifies on every push
+class locked_queue
+{
+private:
+	sjtu::queue<long long> q;
+	std::mutex m;
+	std::condition_variable cv;
+	bool isClosed = false;
+
+public:
+	void push(long long value)
+	{
+		std::lock_guard<std::mutex> lock(m);
+		q.push(value);
+		cv.notify_one();
+	}
+
+	bool pop(long long &out)
+	{
+		std::unique_lock<std::mutex> lock(m);
+		cv.wait(lock, [this]() { return !q.empty() || isClosed; });
+		if (q.empty())
+			return false;
+		out = q.front();
+		q.pop();
+		return true;
+	}
+
+	void close()
+	{
+		std::lock_guard<std::mutex> lock(m);
+		isClosed = true;
+		cv.notify_all();
+	}
+};
+
+void TestSingleThread()
+{
+	std::cout << "Test 1 : Test for try_pop, timeout and close in a single thread...";
+	sjtu::blocking_queue<Integer> q;
+	Integer x(0);
+	if (q.try_pop(x) || q.size_approx() != 0)
+		error();
+	auto start = std::chrono::steady_clock::now();
+	if (q.pop(x, std::chrono::milliseconds(20)) || elapsed(start) < 0.015)
+		error();
+	for (int i = 0; i < 100; ++i)
+		q.push(Integer(i));
+	if (!q.try_pop(x) || !(x == Integer(0)) || !q.pop(x, std::chrono::seconds(1)) || !(x == Integer(1)))
+		error();
+	std::vector<Integer> out(50, Integer(0));
+	if (q.pop_bulk(out.begin(), 50) != 50 || !(out[0] == Integer(2)) || !(out[49] == Integer(51)))
+		error();
+	q.close();
+	try {
+		q.push(Integer(0));
+		error();
+	} catch (...) {}
+	//the elements left can still be popped after close
+	if (q.pop_bulk(out.begin(), 50) != 48 || !(out[47] == Integer(99)))
+		error();
+	if (q.pop(x) || q.pop(x, std::chrono::seconds(1)) || q.pop_bulk(out.begin(), 50) != 0 || !q.closed())
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestWakeUp()
+{
+	std::cout << "Test 2 : Test for waking up sleeping consumers...";
+	sjtu::blocking_queue<std::string> q;
+	std::atomic<int> got(0), finished(0);
+	std::vector<std::thread> consumers;
+	for (int t = 0; t < 4; ++t)
+		consumers.push_back(std::thread([&]() {
+			std::string s;
+			while (q.pop(s))
+				if (s == "ping")
+					++got;
+			++finished;
+		}));
+	for (int i = 0; i < 100; ++i) {
+		std::this_thread::sleep_for(std::chrono::microseconds(200));
+		q.push("ping");
+	}
+	while (got.load() < 100)
+		std::this_thread::yield();
+	if (finished.load() != 0)
+		error();
+	q.close();
+	for (auto &th : consumers)
+		th.join();
+	if (finished.load() != 4)
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestProducersAndConsumers()
+{
+	std::cout << "Test 3 : Test for 4 producers and 4 consumers...";
+	sjtu::blocking_queue<int> q;
+	std::vector<std::atomic<int> > seen(4 * N);
+	for (auto &x : seen)
+		x.store(0);
+	std::vector<std::thread> producers, consumers;
+	for (int t = 0; t < 4; ++t) {
+		producers.push_back(std::thread([&q, t]() {
+			for (int i = 0; i < N; ++i)
+				q.push(t * N + i);
+		}));
+		consumers.push_back(std::thread([&q, &seen, t]() {
+			int buf[64];
+			if (t % 2) {
+				size_t cnt;
+				while ((cnt = q.pop_bulk(buf, 64)) > 0)
+					for (size_t j = 0; j < cnt; ++j)
+						seen[buf[j]]++;
+			}
+			else {
+				while (q.pop(buf[0], std::chrono::seconds(10)))
+					seen[buf[0]]++;
+			}
+		}));
+	}
+	for (auto &th : producers)
+		th.join();
+	q.close();
+	for (auto &th : consumers)
+		th.join();
+	for (auto &x : seen)
+		if (x.load() != 1)
+			error();
+	std::cout << "Correct." << std::endl;
+}
+
+template<class Queue, class PopAll>
+double Transfer(Queue &q, int producers, PopAll popAll)
+{
+	auto start = std::chrono::steady_clock::now();
+	std::atomic<long long> sum(0);
+	std::vector<std::thread> threads;
+	for (int t = 0; t < producers; ++t)
+		threads.push_back(std::thread([&q, t, producers]() {
+			for (long long i = (long long)N * 10 / producers * t; i < (long long)N * 10 / producers * (t + 1); ++i)
+				q.push(i);
+		}));
+	for (int t = 0; t < 2; ++t)
+		threads.push_back(std::thread([&]() {
+			sum += popAll(q);
+		}));
+	for (int t = 0; t < producers; ++t)
+		threads[t].join();
+	q.close();
+	for (size_t t = producers; t < threads.size(); ++t)
+		threads[t].join();
+	if (sum.load() != (long long)N * 10 * (N * 10 - 1) / 2)
+		error();
+	return elapsed(start);
+}
+
+void TestSpeed()
+{
+	std::cout << "Test 4 : Test for speed of passing 2,000,000 elements from 2 producers to 2 consumers..." << std::endl;
+	locked_queue lq;
+	double t = Transfer(lq, 2, [](locked_queue &q) {
+		long long v, local = 0;
+		while (q.pop(v))
+			local += v;
+		return local;
+	});
+	std::cout << "    mutex + sjtu::queue : " << t << "s" << std::endl;
+
+	sjtu::blocking_queue<long long> bq;
+	t = Transfer(bq, 2, [](sjtu::blocking_queue<long long> &q) {
+		long long v, local = 0;
+		while (q.pop(v))
+			local += v;
+		return local;
+	});
+	std::cout << "    blocking_queue pop : " << t << "s" << std::endl;
+
+	sjtu::blocking_queue<long long> bq2;
+	t = Transfer(bq2, 2, [](sjtu::blocking_queue<long long> &q) {
+		long long buf[256], local = 0;
+		size_t cnt;
+		while ((cnt = q.pop_bulk(buf, 256)) > 0)
+			for (size_t j = 0; j < cnt; ++j)
+				local += buf[j];
+		return local;
+	});
+	std::cout << "    blocking_queue pop_bulk : " << t << "s" << std::endl;
+}
+
+int main()
+{
+	TestSingleThread();
+	TestWakeUp();
+	TestProducersAndConsumers();
+	TestSpeed();
+	std::cout << "Congratulations. Your blocking queue has passed all correctness tests." << std::endl;
+	return 0;
+}
@@ -0,0 +1,180 @@
+//Correctness test for sjtu::spsc_queue and sjtu::mpmc_queue with several threads.
+#include <iostream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+
+#include "../common/class-integer.hpp"
+#include "../../include/concurrent_queue.hpp"
+
+const int N = 200000;
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+void TestSingleThread()
+{
+	std::cout << "Test 1 : Test for capacity, full and empty in a single thread...";
+	sjtu::spsc_queue<std::string> sq(100);
+	sjtu::mpmc_queue<std::string> mq(100);
+	if (sq.capacity() != 128 || mq.capacity() != 128 || !sq.empty() || !mq.empty())
+		error();
+	for (int round = 0; round < 3; ++round) {
+		for (int i = 0; i < 128; ++i)
+			if (!sq.try_push(std::to_string(i)) || !mq.try_push(std::to_string(i)))
+				error();
+		if (sq.try_push("x") || mq.try_push("x") || sq.size_approx() != 128 || mq.size_approx() != 128)
+			error();
+		std::string s;
+		for (int i = 0; i < 128; ++i) {
+			if (!sq.try_pop(s) || s != std::to_string(i))
+				error();
+			if (!mq.try_pop(s) || s != std::to_string(i))
+				error();
+		}
+		if (sq.try_pop(s) || mq.try_pop(s))
+			error();
+	}
+	//the elements left are destroyed with the queue
+	sq.try_push("left");
+	mq.try_push("left");
+	std::cout << "Correct." << std::endl;
+}
+
+void TestBulk()
+{
+	std::cout << "Test 2 : Test for try_push_bulk and try_pop_bulk...";
+	sjtu::spsc_queue<Integer> sq(64);
+	sjtu::mpmc_queue<Integer> mq(64);
+	std::vector<Integer> in, out(64, Integer(0));
+	for (int i = 0; i < 100; ++i)
+		in.push_back(Integer(i));
+	if (sq.try_push_bulk(in.begin(), 100) != 64 || mq.try_push_bulk(in.begin(), 100) != 64)
+		error();
+	if (sq.try_push_bulk(in.begin(), 1) != 0 || mq.try_push_bulk(in.begin(), 1) != 0)
+		error();
+	if (sq.try_pop_bulk(out.begin(), 10) != 10 || !(out[9] == Integer(9)))
+		error();
+	if (mq.try_pop_bulk(out.begin(), 10) != 10 || !(out[9] == Integer(9)))
+		error();
+	//the free room wraps around the end of the buffer
+	if (sq.try_push_bulk(in.begin() + 64, 36) != 10 || mq.try_push_bulk(in.begin() + 64, 36) != 10)
+		error();
+	if (sq.try_pop_bulk(out.begin(), 64) != 64 || !(out[0] == Integer(10)) || !(out[63] == Integer(73)))
+		error();
+	if (mq.try_pop_bulk(out.begin(), 64) != 64 || !(out[0] == Integer(10)) || !(out[63] == Integer(73)))
+		error();
+	if (sq.try_pop_bulk(out.begin(), 64) != 0 || mq.try_pop_bulk(out.begin(), 64) != 0)
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestSPSC()
+{
+	std::cout << "Test 3 : Test for the order of one producer and one consumer...";
+	sjtu::spsc_queue<long long> q(256);
+	std::thread producer([&q]() {
+		long long buf[16];
+		for (long long i = 0; i < N;) {
+			if (i % 3 == 0) {
+				long long cnt = 16 < N - i ? 16 : N - i;
+				for (long long j = 0; j < cnt; ++j)
+					buf[j] = i + j;
+				i += q.try_push_bulk(buf, cnt);
+			}
+			else if (q.try_push(i))
+				++i;
+			else
+				std::this_thread::yield();
+		}
+	});
+	bool ordered = true;
+	long long next = 0, buf[16];
+	while (next < N) {
+		size_t cnt = q.try_pop_bulk(buf, 1 + next % 16);
+		if (cnt == 0)
+			std::this_thread::yield();
+		for (size_t j = 0; j < cnt; ++j)
+			if (buf[j] != next++)
+				ordered = false;
+	}
+	producer.join();
+	if (!ordered || !q.empty())
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestMPMC()
+{
+	std::cout << "Test 4 : Test for 4 producers and 4 consumers...";
+	const int threadCnt = 4;
+	sjtu::mpmc_queue<int> q(128);
+	std::vector<std::atomic<int> > seen(threadCnt * N);
+	for (auto &x : seen)
+		x.store(0);
+	std::atomic<int> popped(0);
+	std::atomic<bool> ordered(true);
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < threadCnt; ++t) {
+		threads.push_back(std::thread([&q, t]() {
+			int buf[8];
+			for (int i = 0; i < N;) {
+				if (t % 2) {
+					int cnt = 8 < N - i ? 8 : N - i;
+					for (int j = 0; j < cnt; ++j)
+						buf[j] = t * N + i + j;
+					size_t done = q.try_push_bulk(buf, cnt);
+					if (done == 0)
+						std::this_thread::yield();
+					i += done;
+				}
+				else if (q.try_push(t * N + i))
+					++i;
+				else
+					std::this_thread::yield();
+			}
+		}));
+		threads.push_back(std::thread([&, t]() {
+			//the elements from one producer must come out in order to any single consumer
+			std::vector<int> last(threadCnt, -1);
+			int buf[8];
+			while (popped.load() < threadCnt * N) {
+				size_t cnt = t % 2 ? q.try_pop_bulk(buf, 8) : q.try_pop(buf[0]);
+				if (cnt == 0)
+					std::this_thread::yield();
+				for (size_t j = 0; j < cnt; ++j) {
+					int from = buf[j] / N, index = buf[j] % N;
+					if (index <= last[from])
+						ordered = false;
+					last[from] = index;
+					seen[buf[j]]++;
+				}
+				popped += cnt;
+			}
+		}));
+	}
+	for (auto &th : threads)
+		th.join();
+
+	for (auto &x : seen)
+		if (x.load() != 1)
+			error();
+	if (!ordered || !q.empty())
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+int main()
+{
+	TestSingleThread();
+	TestBulk();
+	TestSPSC();
+	TestMPMC();
+	std::cout << "Congratulations. Your concurrent queues have passed all correctness tests." << std::endl;
+	return 0;
+}
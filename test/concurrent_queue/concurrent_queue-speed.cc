@@ -0,0 +1,174 @@
+//Throughput and latency of sjtu::spsc_queue and sjtu::mpmc_queue against sjtu::queue guarded by a mutex.
+//The numbers depend heavily on the number of cores, on a single core the threads only take turns.
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+#include "../../include/queue.hpp"
+#include "../../include/concurrent_queue.hpp"
+
+const int N = 2000000;
+const int batch = 32;
+
+//a bounded sjtu::queue behind a mutex, offering the same try_push and try_pop
+class locked_queue
+{
+private:
+	sjtu::queue<long long> q;
+	std::mutex m;
+	size_t cap;
+
+public:
+	explicit locked_queue(size_t capacity) : cap(capacity) {}
+
+	bool try_push(long long value)
+	{
+		std::lock_guard<std::mutex> lock(m);
+		if (q.size() >= cap)
+			return false;
+		q.push(value);
+		return true;
+	}
+
+	bool try_pop(long long &out)
+	{
+		std::lock_guard<std::mutex> lock(m);
+		if (q.empty())
+			return false;
+		out = q.front();
+		q.pop();
+		return true;
+	}
+};
+
+double elapsed(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+//push or pop a single element at a time
+template<class Queue>
+struct single_ops
+{
+	static size_t push(Queue &q, const long long *buf, size_t /*n*/)
+	{
+		return q.try_push(buf[0]) ? 1 : 0;
+	}
+
+	static size_t pop(Queue &q, long long *buf, size_t /*n*/)
+	{
+		return q.try_pop(buf[0]) ? 1 : 0;
+	}
+};
+
+//push or pop up to n elements at a time
+template<class Queue>
+struct bulk_ops
+{
+	static size_t push(Queue &q, const long long *buf, size_t n)
+	{
+		return q.try_push_bulk(buf, n);
+	}
+
+	static size_t pop(Queue &q, long long *buf, size_t n)
+	{
+		return q.try_pop_bulk(buf, n);
+	}
+};
+
+//each of the producers pushes N / producers elements, and the consumers check the sum of all of them
+template<class Queue, class Ops>
+void TestThroughput(const char *name, int producers, int consumers)
+{
+	Queue q(1024);
+	std::atomic<long long> popped(0), sum(0);
+	auto start = std::chrono::steady_clock::now();
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < producers; ++t)
+		threads.push_back(std::thread([&, t]() {
+			long long buf[batch];
+			const long long from = (long long)N / producers * t, to = (long long)N / producers * (t + 1);
+			for (long long i = from; i < to;) {
+				size_t n = std::min((long long)batch, to - i);
+				for (size_t j = 0; j < n; ++j)
+					buf[j] = i + j;
+				size_t done = Ops::push(q, buf, n);
+				if (done == 0)
+					std::this_thread::yield();
+				i += done;
+			}
+		}));
+	for (int t = 0; t < consumers; ++t)
+		threads.push_back(std::thread([&]() {
+			long long buf[batch], local = 0;
+			while (popped.load(std::memory_order_relaxed) < N) {
+				size_t done = Ops::pop(q, buf, batch);
+				if (done == 0)
+					std::this_thread::yield();
+				for (size_t j = 0; j < done; ++j)
+					local += buf[j];
+				popped += done;
+			}
+			sum += local;
+		}));
+	for (auto &th : threads)
+		th.join();
+
+	double t = elapsed(start);
+	if (sum.load() != (long long)N * (N - 1) / 2) {
+		std::cout << "Error, mismatch found." << std::endl;
+		exit(0);
+	}
+	std::cout << name << " " << producers << "P" << consumers << "C : "
+		<< (long long)(N / t) << " ops/s" << std::endl;
+}
+
+//one thread sends a timestamp and the other sends it back, the round trips are sorted for percentiles
+void TestLatency()
+{
+	const int rounds = 20000;
+	sjtu::spsc_queue<long long> ping(64), pong(64);
+	std::thread echo([&]() {
+		long long v;
+		for (int i = 0; i < rounds; ++i) {
+			while (!ping.try_pop(v))
+				std::this_thread::yield();
+			while (!pong.try_push(v))
+				std::this_thread::yield();
+		}
+	});
+
+	std::vector<long long> trip;
+	auto base = std::chrono::steady_clock::now();
+	for (int i = 0; i < rounds; ++i) {
+		long long v = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - base).count();
+		while (!ping.try_push(v))
+			std::this_thread::yield();
+		while (!pong.try_pop(v))
+			std::this_thread::yield();
+		trip.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - base).count() - v);
+	}
+	echo.join();
+
+	std::sort(trip.begin(), trip.end());
+	std::cout << "spsc_queue round trip : p50 " << trip[rounds / 2] << "ns, p99 " << trip[rounds * 99 / 100]
+		<< "ns, p99.9 " << trip[rounds * 999 / 1000] << "ns" << std::endl;
+}
+
+int main()
+{
+	std::cout << "hardware threads : " << std::thread::hardware_concurrency() << std::endl;
+	TestThroughput<locked_queue, single_ops<locked_queue> >("mutex + sjtu::queue", 1, 1);
+	TestThroughput<sjtu::spsc_queue<long long>, single_ops<sjtu::spsc_queue<long long> > >("spsc_queue", 1, 1);
+	TestThroughput<sjtu::spsc_queue<long long>, bulk_ops<sjtu::spsc_queue<long long> > >("spsc_queue bulk", 1, 1);
+	TestThroughput<locked_queue, single_ops<locked_queue> >("mutex + sjtu::queue", 4, 4);
+	TestThroughput<sjtu::mpmc_queue<long long>, single_ops<sjtu::mpmc_queue<long long> > >("mpmc_queue", 4, 4);
+	TestThroughput<sjtu::mpmc_queue<long long>, bulk_ops<sjtu::mpmc_queue<long long> > >("mpmc_queue bulk", 4, 4);
+	TestLatency();
+	return 0;
+}
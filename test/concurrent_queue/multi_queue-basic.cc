@@ -0,0 +1,195 @@
+//Correctness test for sjtu::multi_queue, and the rank error of its pops against an exact priority queue.
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <random>
+#include <functional>
+#include <thread>
+#include <atomic>
+
+#include "../../include/priority_queue.hpp"
+#include "../../include/concurrent_queue.hpp"
+
+std::default_random_engine myRandom(20181031);
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+//every pushed element comes out exactly once, and try_pop fails only when the queue is empty
+template<class T, class Compare, class Heap, class Gen>
+void TestSingle(const char *name, Gen gen)
+{
+	std::cout << "Test for push and try_pop in a single thread with " << name << "...";
+	sjtu::multi_queue<T, Compare, Heap> q(4);
+	std::vector<T> in, out;
+	T v;
+	for (int i = 0; i < 200000; ++i) {
+		if (myRandom() % 3 != 0) {
+			in.push_back(gen());
+			q.push(in.back());
+		}
+		else if (q.try_pop(v))
+			out.push_back(v);
+		else if (in.size() != out.size())
+			error();
+		if (q.size_approx() != in.size() - out.size())
+			error();
+	}
+	while (q.try_pop(v))
+		out.push_back(v);
+	if (!q.empty() || q.try_pop(v))
+		error();
+
+	std::sort(in.begin(), in.end());
+	std::sort(out.begin(), out.end());
+	if (in != out)
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+//the threads push their own numbers and pop at the same time, then the whole queue is drained
+void TestThreads(int threads)
+{
+	std::cout << "Test for " << threads << " threads pushing and popping...";
+	const int N = 400000;
+	sjtu::multi_queue<long long> q(threads);
+	std::atomic<long long> sum(0), popped(0);
+	std::vector<std::thread> th;
+	for (int t = 0; t < threads; ++t)
+		th.push_back(std::thread([&, t]() {
+			long long local = 0, cnt = 0, v;
+			for (long long i = t; i < N; i += threads) {
+				q.push(i);
+				if (i % 3 == 0 && q.try_pop(v)) {
+					local += v;
+					++cnt;
+				}
+			}
+			sum += local;
+			popped += cnt;
+		}));
+	for (auto &x : th)
+		x.join();
+
+	long long v;
+	while (q.try_pop(v)) {
+		sum += v;
+		++popped;
+	}
+	if (popped.load() != N || sum.load() != (long long)N * (N - 1) / 2 || !q.empty())
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+//a comparator with state, popping the smaller numbers first when ascending
+struct Order
+{
+	bool ascending;
+
+	explicit Order(bool a = false) : ascending(a) {}
+
+	bool operator()(int a, int b) const { return ascending ? a > b : a < b; }
+};
+
+//with two heaps, a single thread always compares both tops, so the numbers come out in exact order
+//as long as the heaps are ordered by the comparator given to the queue
+void TestCompare()
+{
+	std::cout << "Test for a comparator with state...";
+	const int N = 100000;
+	std::vector<int> a(N);
+	for (int i = 0; i < N; ++i)
+		a[i] = i;
+	std::shuffle(a.begin(), a.end(), myRandom);
+
+	sjtu::multi_queue<int, Order> q(1, 2, Order(true));
+	for (int i = 0; i < N; ++i)
+		q.push(a[i]);
+	int v;
+	for (int i = 0; i < N; ++i)
+		if (!q.try_pop(v) || v != i)
+			error();
+	if (q.try_pop(v))
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+//number of present values greater than x, for a permutation of 0 .. n-1
+class Fenwick
+{
+private:
+	std::vector<int> t;
+
+public:
+	explicit Fenwick(int n) : t(n + 1, 0) {}
+
+	void add(int x, int d)
+	{
+		for (++x; x < (int)t.size(); x += x & -x)
+			t[x] += d;
+	}
+
+	int prefix(int x) const//number of present values <= x
+	{
+		int ans = 0;
+		for (++x; x > 0; x -= x & -x)
+			ans += t[x];
+		return ans;
+	}
+};
+
+//a pop taking the k-th greatest element has a rank error of k-1.
+//half of the elements are popped, while the other half are pushed in between
+void TestRankError(size_t heaps)
+{
+	const int n = 400000;
+	std::vector<int> a(n);
+	for (int i = 0; i < n; ++i)
+		a[i] = i;
+	std::shuffle(a.begin(), a.end(), myRandom);
+
+	sjtu::multi_queue<int> q(heaps, 1);
+	Fenwick present(n);
+	int total = 0;
+	for (int i = 0; i < n / 2; ++i) {
+		q.push(a[i]);
+		present.add(a[i], 1);
+		++total;
+	}
+
+	long long sum = 0;
+	int worst = 0, v;
+	for (int i = n / 2; i < n; ++i) {
+		if (!q.try_pop(v))
+			error();
+		const int rank = total - present.prefix(v);
+		sum += rank;
+		worst = std::max(worst, rank);
+		present.add(v, -1);
+		q.push(a[i]);
+		present.add(a[i], 1);
+	}
+	std::cout << "    " << q.heaps() << " heaps : mean " << (double)sum / (n / 2) << ", max " << worst << std::endl;
+}
+
+int main()
+{
+	TestSingle<int, std::less<int>, sjtu::binary_heap<int> >("int", []() { return (int)(myRandom() % 100000); });
+	TestSingle<std::string, std::greater<std::string>, sjtu::dary_heap<std::string, std::greater<std::string> > >
+		("string, greater and dary_heap", []() { return std::to_string(myRandom() % 100000); });
+	TestCompare();
+	TestThreads(2);
+	TestThreads(4);
+	TestThreads(8);
+
+	std::cout << "Test for the rank error of 200,000 pops among 200,000 elements..." << std::endl;
+	TestRankError(2);
+	TestRankError(8);
+	TestRankError(32);
+	TestRankError(128);
+	return 0;
+}
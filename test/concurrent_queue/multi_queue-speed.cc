@@ -0,0 +1,205 @@
+//Scaling of sjtu::multi_queue against sjtu::priority_queue guarded by a mutex, for random operations and parallel Dijkstra.
+//The numbers depend heavily on the number of cores, on a single core the threads only take turns.
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <random>
+#include <utility>
+#include <functional>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <chrono>
+
+#include "../../include/priority_queue.hpp"
+#include "../../include/concurrent_queue.hpp"
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+double elapsed(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+//a sjtu::priority_queue behind a mutex, offering the same push and try_pop
+template<typename T, class Compare>
+class locked_queue
+{
+private:
+	sjtu::priority_queue<T, Compare, sjtu::binary_heap<T, Compare> > q;
+	std::mutex m;
+
+public:
+	explicit locked_queue(size_t) {}
+
+	void push(const T &value)
+	{
+		std::lock_guard<std::mutex> lock(m);
+		q.push(value);
+	}
+
+	bool try_pop(T &out)
+	{
+		std::lock_guard<std::mutex> lock(m);
+		if (q.empty())
+			return false;
+		out = q.top();
+		q.pop();
+		return true;
+	}
+};
+
+//the queue starts with 1,000,000 elements, and each thread pushes and pops at random
+template<class Queue>
+void TestThroughput(const char *name, int threads)
+{
+	const int N = 4000000;
+	Queue q(threads);
+	std::default_random_engine r(1);
+	for (int i = 0; i < 1000000; ++i)
+		q.push(r());
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> th;
+	for (int t = 0; t < threads; ++t)
+		th.push_back(std::thread([&, t]() {
+			std::default_random_engine mine(t + 2);
+			unsigned v;
+			for (int i = 0; i < N / threads; ++i) {
+				if (mine() % 2)
+					q.push(mine());
+				else if (!q.try_pop(v))
+					error();
+			}
+		}));
+	for (auto &x : th)
+		x.join();
+	std::cout << "    " << name << " " << threads << " threads : " << (long long)(N / elapsed(start)) << " ops/s" << std::endl;
+}
+
+const int n = 100000;
+const int m = 1000000;
+
+struct Edge {
+	int v, w;
+	Edge(int _v, int _w) : v(_v), w(_w) {}
+};
+
+std::vector<std::vector<Edge> > to(n + 1);
+
+void ConstructGraph()
+{
+	std::default_random_engine r(20181031);
+	std::uniform_int_distribution<int> vertex(1, n);
+	std::uniform_int_distribution<int> weight(1, 100000);
+	for (int i = 0; i < m; ++i) {
+		int u = vertex(r), v = vertex(r);
+		to[u].push_back(Edge(v, weight(r)));
+	}
+}
+
+typedef std::pair<unsigned long long, int> State;//(distance, vertex)
+
+std::vector<unsigned long long> Dijkstra()
+{
+	std::priority_queue<State, std::vector<State>, std::greater<State> > pq;
+	std::vector<unsigned long long> dist(n + 1, ~0ULL);
+	dist[1] = 0;
+	pq.push(State(0, 1));
+	while (!pq.empty()) {
+		State s = pq.top();
+		pq.pop();
+		if (s.first > dist[s.second])
+			continue;
+		for (const Edge &e : to[s.second]) {
+			unsigned long long d = s.first + e.w;
+			if (d < dist[e.v]) {
+				dist[e.v] = d;
+				pq.push(State(d, e.v));
+			}
+		}
+	}
+	return dist;
+}
+
+//Since a pop may come out of order, a vertex is expanded again whenever its distance has improved since.
+//pending counts the states pushed but not expanded yet, so the threads stop once it drops to 0
+template<class Queue>
+void ParallelDijkstra(const char *name, int threads, const std::vector<unsigned long long> &expected)
+{
+	Queue q(threads);
+	std::vector<std::atomic<unsigned long long> > dist(n + 1);
+	for (auto &d : dist)
+		d.store(~0ULL, std::memory_order_relaxed);
+	std::atomic<long long> pending(1), expanded(0);
+	dist[1].store(0);
+	q.push(State(0, 1));
+
+	auto start = std::chrono::steady_clock::now();
+	std::vector<std::thread> th;
+	for (int t = 0; t < threads; ++t)
+		th.push_back(std::thread([&]() {
+			State s;
+			long long local = 0;
+			while (pending.load(std::memory_order_acquire) > 0) {
+				if (!q.try_pop(s)) {
+					std::this_thread::yield();
+					continue;
+				}
+				if (s.first == dist[s.second].load(std::memory_order_relaxed)) {
+					++local;
+					for (const Edge &e : to[s.second]) {
+						unsigned long long d = s.first + e.w, cur = dist[e.v].load(std::memory_order_relaxed);
+						while (d < cur) {
+							if (dist[e.v].compare_exchange_weak(cur, d, std::memory_order_relaxed)) {
+								pending.fetch_add(1, std::memory_order_relaxed);
+								q.push(State(d, e.v));
+								break;
+							}
+						}
+					}
+				}
+				pending.fetch_sub(1, std::memory_order_release);
+			}
+			expanded += local;
+		}));
+	for (auto &x : th)
+		x.join();
+
+	double t = elapsed(start);
+	for (int i = 1; i <= n; ++i)
+		if (dist[i].load() != expected[i])
+			error();
+	std::cout << "    " << name << " " << threads << " threads : " << t << "s, "
+		<< expanded.load() << " expansions" << std::endl;
+}
+
+int main()
+{
+	typedef sjtu::multi_queue<unsigned> Multi;
+	typedef locked_queue<unsigned, std::less<unsigned> > Locked;
+	std::cout << "hardware threads : " << std::thread::hardware_concurrency() << std::endl;
+	std::cout << "Test for speed of 4,000,000 random pushes and pops..." << std::endl;
+	for (int threads = 1; threads <= 8; threads *= 2) {
+		TestThroughput<Locked>("mutex + sjtu::priority_queue", threads);
+		TestThroughput<Multi>("multi_queue", threads);
+	}
+
+	ConstructGraph();
+	std::vector<unsigned long long> expected = Dijkstra();
+	typedef sjtu::multi_queue<State, std::greater<State> > MultiState;
+	typedef locked_queue<State, std::greater<State> > LockedState;
+	std::cout << "Test for speed of Dijkstra with " << n << " vertices and " << m << " edges..." << std::endl;
+	auto start = std::chrono::steady_clock::now();
+	Dijkstra();
+	std::cout << "    std::priority_queue sequential : " << elapsed(start) << "s" << std::endl;
+	for (int threads = 1; threads <= 8; threads *= 2) {
+		ParallelDijkstra<LockedState>("mutex + sjtu::priority_queue", threads, expected);
+		ParallelDijkstra<MultiState>("multi_queue", threads, expected);
+	}
+	return 0;
+}
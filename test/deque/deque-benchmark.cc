@@ -0,0 +1,204 @@
+//Latency benchmark of sjtu::deque (with sqrt and fixed block size) and sjtu::fixed_block_deque on the workloads of deque-advan-2/3.
+//Every single operation is timed, so that the tail latency caused by
+//rebalancing the blocks shows up in p99/p99.9/max.
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include <algorithm>
+#include <vector>
+
+#include "../../include/deque.hpp"
+
+static const int N_SPEED = 210000;
+
+typedef std::chrono::steady_clock Clock;
+
+class LatencyRecorder
+{
+private:
+	std::vector<double> samples;//in microseconds
+	Clock::time_point startPoint;
+
+public:
+	void reserve(size_t n)
+	{
+		samples.reserve(n);
+	}
+
+	void start()
+	{
+		startPoint = Clock::now();
+	}
+
+	void stop()
+	{
+		samples.push_back(std::chrono::duration<double, std::micro>(Clock::now() - startPoint).count());
+	}
+
+	void report(const char *name)
+	{
+		std::sort(samples.begin(), samples.end());
+		double total = 0;
+		for (size_t i = 0; i < samples.size(); i++)
+			total += samples[i];
+
+		const size_t n = samples.size();
+		std::cout << std::left << std::setw(28) << name << std::right << std::fixed << std::setprecision(2)
+			<< " total(ms)=" << std::setw(9) << total / 1000
+			<< " p50(us)=" << std::setw(7) << samples[n / 2]
+			<< " p99(us)=" << std::setw(7) << samples[n * 99 / 100]
+			<< " p99.9(us)=" << std::setw(8) << samples[n * 999 / 1000]
+			<< " max(us)=" << std::setw(9) << samples[n - 1] << std::endl;
+		samples.clear();
+	}
+};
+
+template<class Deque>
+void fill(Deque &a, int n)
+{
+	for (int i = 0; i < n; i++)
+	{
+		int op = rand() % 3;
+		if (op == 0) a.push_back(rand());
+		else if (op == 1) a.push_front(rand());
+		else a.insert(a.begin() + rand() % (a.size() + 1), rand());
+	}
+}
+
+//middleOps is the number of timed random insert/erase,
+//which is reduced for containers with O(n) middle insertion
+template<class Deque>
+void BenchmarkDeque(const char *title, int middleOps)
+{
+	std::cout << "[" << title << "]" << std::endl;
+	LatencyRecorder rec;
+	rec.reserve(N_SPEED);
+
+	{
+		srand(2017);
+		Deque a;
+		for (int i = 0; i < N_SPEED; i++)
+		{
+			rec.start();
+			a.push_back(i);
+			rec.stop();
+		}
+		rec.report("push_back");
+	}
+
+	{
+		srand(2017);
+		Deque a;
+		for (int i = 0; i < N_SPEED; i++)
+		{
+			rec.start();
+			a.push_front(i);
+			rec.stop();
+		}
+		rec.report("push_front");
+	}
+
+	{
+		srand(2017);
+		Deque a;
+		for (int i = 0; i < N_SPEED; i++)
+		{
+			int op = rand() % 3;
+			int pos = rand() % (a.size() + 1);
+			rec.start();
+			if (op == 0) a.push_back(i);
+			else if (op == 1) a.push_front(i);
+			else a.insert(a.begin() + pos, i);
+			rec.stop();
+		}
+		rec.report("mixed push/insert");
+	}
+
+	{
+		srand(2017);
+		Deque a;
+		fill(a, N_SPEED);
+		for (int i = 0; i < middleOps; i++)
+		{
+			int pos = rand() % (a.size() + 1);
+			rec.start();
+			a.insert(a.begin() + pos, i);
+			rec.stop();
+		}
+		rec.report("random insert");
+	}
+
+	{
+		srand(2017);
+		Deque a;
+		fill(a, N_SPEED);
+		for (int i = 0; i < middleOps; i++)
+		{
+			int pos = rand() % a.size();
+			rec.start();
+			a.erase(a.begin() + pos);
+			rec.stop();
+		}
+		rec.report("random erase");
+	}
+
+	{
+		srand(2017);
+		Deque a;
+		fill(a, N_SPEED);
+		long long sum = 0;
+		for (int i = 0; i < N_SPEED; i++)
+		{
+			int pos = rand() % a.size();
+			rec.start();
+			sum += a[pos];
+			rec.stop();
+		}
+		rec.report("random access");
+		if (sum == 1)
+			std::cout << sum << std::endl;
+	}
+
+	//the front node is full, so every push_front adds a node and every pop_front removes it
+	{
+		Deque a;
+		for (int i = 0; i < N_SPEED; i++)
+			a.push_back(i);
+		long long sum = 0;
+		for (int i = 0; i < N_SPEED; i++)
+		{
+			rec.start();
+			a.push_front(i);
+			sum += a[a.size() / 2];
+			a.pop_front();
+			rec.stop();
+		}
+		rec.report("push_front/access/pop");
+		if (sum == 1)
+			std::cout << sum << std::endl;
+	}
+
+	{
+		srand(2017);
+		Deque a;
+		fill(a, N_SPEED);
+		for (int i = 0; i < N_SPEED; i++)
+		{
+			bool front = rand() % 2;
+			rec.start();
+			if (front) a.pop_front();
+			else a.pop_back();
+			rec.stop();
+		}
+		rec.report("random pop");
+	}
+}
+
+int main()
+{
+	BenchmarkDeque<sjtu::deque<int> >("sjtu::deque", N_SPEED);
+	BenchmarkDeque<sjtu::deque<int, sjtu::fixed_bytes_block_policy<4096> > >("sjtu::deque with 4 KiB blocks", N_SPEED);
+	BenchmarkDeque<sjtu::fixed_block_deque<int> >("sjtu::fixed_block_deque", N_SPEED / 100);
+	return 0;
+}
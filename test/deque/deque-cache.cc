@@ -0,0 +1,172 @@
+//Test for the block cache of sjtu::deque.
+//Every node of the deque is created by operator new, so counting the calls of it
+//tells whether push and pop in a steady state allocate memory.
+#include <iostream>
+#include <deque>
+#include <random>
+#include <string>
+#include <cstdlib>
+#include <new>
+
+#include "../../include/deque.hpp"
+
+static long long newCnt = 0;
+
+void* operator new(size_t size)
+{
+	++newCnt;
+	void *p = std::malloc(size ? size : 1);
+	if (!p)
+		throw std::bad_alloc();
+	return p;
+}
+
+void operator delete(void *p) noexcept
+{
+	std::free(p);
+}
+
+void operator delete(void *p, size_t) noexcept
+{
+	std::free(p);
+}
+
+std::default_random_engine myRandom(20180207);
+const int N = 1000000;
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+void TestSteadyFifo()
+{
+	std::cout << "Test 1 : Test for allocations of FIFO traffic in a steady state...";
+	sjtu::deque<int> d;
+	for (int i = 0; i < 10000; ++i)
+		d.push_back(i);
+	for (int i = 0; i < 100000; ++i) {//warm up
+		d.push_back(i);
+		d.pop_front();
+	}
+
+	long long before = newCnt;
+	long long sum = 0;
+	for (int i = 0; i < N; ++i) {
+		d.push_back(i);
+		sum += d.front();
+		d.pop_front();
+	}
+	if (newCnt != before || d.size() != 10000 || d.front() != N - 10000)
+		error();
+	std::cout << "Correct. (" << newCnt - before << " allocations)" << std::endl;
+	if (sum == -1)
+		std::cout << sum << std::endl;
+}
+
+void TestSteadyLifo()
+{
+	std::cout << "Test 2 : Test for allocations of both ends traffic in a steady state...";
+	sjtu::deque<int> d;
+	for (int i = 0; i < 10000; ++i)
+		d.push_front(i);
+	for (int i = 0; i < 100000; ++i) {
+		d.push_front(i);
+		d.pop_back();
+	}
+
+	long long before = newCnt;
+	for (int i = 0; i < N; ++i) {
+		if (i % 2000 < 1000) {
+			d.push_front(i);
+			d.pop_back();
+		}
+		else {
+			d.push_back(i);
+			d.pop_front();
+		}
+	}
+	if (newCnt != before || d.size() != 10000)
+		error();
+	std::cout << "Correct. (" << newCnt - before << " allocations)" << std::endl;
+}
+
+void TestCacheLimit()
+{
+	std::cout << "Test 3 : Test for cache_limit() and set_cache_limit()...";
+	sjtu::deque<int> d;
+	if (d.cache_limit() != 4)
+		error();
+	d.set_cache_limit(0);
+	for (int i = 0; i < 10000; ++i)
+		d.push_back(i);
+
+	long long before = newCnt;
+	for (int i = 0; i < N / 10; ++i) {
+		d.push_back(i);
+		d.pop_front();
+	}
+	if (newCnt == before)
+		error();
+
+	d.set_cache_limit(16);
+	sjtu::deque<int> e(d);
+	if (e.cache_limit() != 16)
+		error();
+	d.clear();
+	for (int i = 0; i < 10000; ++i)
+		d.push_back(i);
+	d.set_cache_limit(1);
+	std::cout << "Correct." << std::endl;
+}
+
+void TestCorrectness()
+{
+	std::cout << "Test 4 : Test for random operations with recycled blocks...";
+	sjtu::deque<std::string> d;
+	std::deque<std::string> s;
+	d.set_cache_limit(64);
+	for (int i = 0; i < N; ++i) {
+		int op = myRandom() % 6;
+		std::string v = std::to_string(i);
+		if (op == 0 || op == 1) {
+			d.push_back(v);
+			s.push_back(v);
+		}
+		else if (op == 2) {
+			d.push_front(v);
+			s.push_front(v);
+		}
+		else if (s.empty())
+			continue;
+		else if (op == 3) {
+			d.pop_front();
+			s.pop_front();
+		}
+		else if (op == 4) {
+			d.pop_back();
+			s.pop_back();
+		}
+		else if (i % 100 == 5) {
+			size_t k = myRandom() % s.size();
+			d.erase(d.begin() + k);
+			s.erase(s.begin() + k);
+		}
+	}
+	if (d.size() != s.size())
+		error();
+	for (size_t i = 0; i < s.size(); ++i)
+		if (d[i] != s[i])
+			error();
+	std::cout << "Correct." << std::endl;
+}
+
+int main()
+{
+	TestSteadyFifo();
+	TestSteadyLifo();
+	TestCacheLimit();
+	TestCorrectness();
+	return 0;
+}
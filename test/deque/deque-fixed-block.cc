@@ -0,0 +1,252 @@
+//Correctness test for sjtu::fixed_block_deque, checked against std::deque.
+#include <iostream>
+#include <deque>
+#include <random>
+#include <string>
+#include <stdexcept>
+
+#include "../common/class-bint.hpp"
+#include "../common/class-integer.hpp"
+#include "../../include/deque.hpp"
+
+std::default_random_engine myRandom(20171117);
+const int N = 100005;
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+template<class T>
+bool isEqual(const std::deque<T> &a, const sjtu::fixed_block_deque<T> &b)
+{
+	if (a.size() != b.size())
+		return false;
+
+	size_t i = 0;
+	for (auto it = b.cbegin(); it != b.cend(); ++it, ++i)
+		if (!(*it == a[i]))
+			return false;
+
+	return i == a.size();
+}
+
+void TestInteger()
+{
+	std::cout << "Test 1 : Test for classes without default constructor...";
+	sjtu::fixed_block_deque<Integer> dInt;
+	std::deque<Integer> vInt;
+	for (int i = 0; i < N; ++i) {
+		vInt.push_back(Integer(i));
+		dInt.push_back(Integer(i));
+	}
+	for (int i = 0; i < N; ++i) {
+		if (!(vInt[i] == dInt[i]))
+			error();
+	}
+	std::cout << "Correct." << std::endl;
+}
+
+void TestBint()
+{
+	std::cout << "Test 2 : Test for big integer at both ends...";
+	sjtu::fixed_block_deque<Util::Bint> dBint;
+	std::deque<Util::Bint> vBint;
+	for (long long i = 1LL << 50; i < (1LL << 50) + N; ++i) {
+		if (i & 1) {
+			vBint.push_back(Util::Bint(i) * (i % 1007));
+			dBint.push_back(vBint.back());
+		}
+		else {
+			vBint.push_front(Util::Bint(i) * (i % 1007));
+			dBint.push_front(vBint.front());
+		}
+	}
+	if (!isEqual(vBint, dBint))
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestCopyConstructorAndOperatorEqu()
+{
+	std::cout << "Test 3 : Test for copy constructor and operator=...";
+	sjtu::fixed_block_deque<std::string> *pStr = new sjtu::fixed_block_deque<std::string>;
+	std::deque<std::string> vStr;
+	for (int i = 0; i < N; ++i) {
+		pStr->push_back(std::to_string(i));
+		vStr.push_back(std::to_string(i));
+	}
+	sjtu::fixed_block_deque<std::string> dual(*pStr), dualOper;
+	dualOper = *pStr;
+	dualOper = dualOper;
+	delete pStr;
+	if (!isEqual(vStr, dual) || !isEqual(vStr, dualOper))
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestIterator()
+{
+	std::cout << "Test 4 : Test for iterator arithmetic...";
+	sjtu::fixed_block_deque<int> dInt;
+	for (int i = 0; i < N; ++i)
+		dInt.push_front(i);
+	std::uniform_int_distribution<int> pos(0, N - 1);
+	for (int i = 0; i < N; ++i) {
+		int a = pos(myRandom), b = pos(myRandom);
+		auto ia = dInt.begin() + a;
+		auto ib = dInt.end() - (N - b);
+		if (ia - ib != a - b || *ia != N - 1 - a || *ib != N - 1 - b)
+			error();
+		ia += b - a;
+		if (ia != ib)
+			error();
+	}
+	try {
+		dInt.end() + 1;
+		error();
+	} catch (...) {}
+	try {
+		dInt.begin() - 1;
+		error();
+	} catch (...) {}
+	std::cout << "Correct." << std::endl;
+}
+
+void TestInsertAndErase()
+{
+	std::cout << "Test 5 : Test for random erase and insert...";
+	sjtu::fixed_block_deque<long long> dInt;
+	std::deque<long long> vInt;
+	for (long long i = 0; i < 10000; ++i) {
+		int op = myRandom() % 5;
+		if (op <= 2 || vInt.empty()) {
+			size_t k = myRandom() % (vInt.size() + 1);
+			vInt.insert(vInt.begin() + k, i);
+			if (*dInt.insert(dInt.begin() + k, i) != i)
+				error();
+		}
+		else {
+			size_t k = myRandom() % vInt.size();
+			vInt.erase(vInt.begin() + k);
+			auto it = dInt.erase(dInt.begin() + k);
+			if (k < vInt.size() && *it != vInt[k])
+				error();
+		}
+	}
+	if (!isEqual(vInt, dInt))
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestPopAndPush()
+{
+	std::cout << "Test 6 : Test for pop() and push() as a FIFO queue...";
+	sjtu::fixed_block_deque<int> dInt;
+	std::deque<int> vInt;
+	for (int i = 0; i < 10 * N; ++i) {
+		dInt.push_back(i);
+		vInt.push_back(i);
+		if (i % 3 != 0) {
+			if (dInt.front() != vInt.front())
+				error();
+			dInt.pop_front();
+			vInt.pop_front();
+		}
+	}
+	if (!isEqual(vInt, dInt) || dInt.back() != vInt.back())
+		error();
+	dInt.clear();
+	for (int i = 0; i < N; ++i)
+		dInt.push_front(i);
+	for (int i = 0; i < N; ++i)
+		dInt.pop_back();
+	if (!dInt.empty())
+		error();
+	try {
+		dInt.pop_front();
+		error();
+	} catch (...) {}
+	std::cout << "Correct." << std::endl;
+}
+
+//a string whose copy throws while failCopy is set
+bool failCopy = false;
+
+struct Fragile
+{
+	std::string s;
+
+	explicit Fragile(const std::string &_s) : s(_s) {}
+	Fragile(const Fragile &other) : s(other.s)
+	{
+		if (failCopy)
+			throw std::runtime_error("copy");
+	}
+	Fragile(Fragile &&) = default;
+	Fragile &operator=(const Fragile &) = default;
+
+	bool operator==(const Fragile &rhs) const { return s == rhs.s; }
+};
+
+void TestAliasAndThrow()
+{
+	std::cout << "Test 7 : Test for inserting its own elements and copies that throw...";
+	sjtu::fixed_block_deque<Fragile> dStr;
+	std::deque<Fragile> vStr;
+	for (int i = 0; i < 3000; ++i) {
+		if (vStr.empty()) {
+			vStr.push_back(Fragile(std::to_string(i)));
+			dStr.push_back(Fragile(std::to_string(i)));
+			continue;
+		}
+		size_t k = myRandom() % (vStr.size() + 1), v = myRandom() % vStr.size();
+		Fragile value(vStr[v]);
+		int op = myRandom() % 4;
+		if (op == 0) {
+			vStr.push_front(value);
+			dStr.push_front(dStr[v]);
+		}
+		else if (op == 1) {
+			vStr.push_back(value);
+			dStr.push_back(dStr[v]);
+		}
+		else if (op == 2) {
+			vStr.insert(vStr.begin() + k, value);
+			dStr.insert(dStr.begin() + k, dStr[v]);
+		}
+		else {
+			//nothing changes when the copy throws
+			failCopy = true;
+			try {
+				if (myRandom() % 2)
+					dStr.push_front(value);
+				else
+					dStr.insert(dStr.begin() + k, value);
+				error();
+			} catch (std::runtime_error &) {}
+			failCopy = false;
+		}
+		if (dStr.front().s != vStr.front().s || dStr.back().s != vStr.back().s)
+			error();
+	}
+	if (!isEqual(vStr, dStr))
+		error();
+	while (!dStr.empty())
+		dStr.pop_back();
+	std::cout << "Correct." << std::endl;
+}
+
+int main()
+{
+	TestInteger();
+	TestBint();
+	TestCopyConstructorAndOperatorEqu();
+	TestIterator();
+	TestInsertAndErase();
+	TestPopAndPush();
+	TestAliasAndThrow();
+	std::cout << "Congratulations. Your fixed_block_deque has passed all correctness tests." << std::endl;
+	return 0;
+}
@@ -0,0 +1,170 @@
+//Count the copies and moves done by sjtu::deque.
+//Rebalancing the blocks (split, merge, insert and erase) should only move the elements,
+//so the number of copies equals the number of values handed to the deque.
+#include <iostream>
+#include <deque>
+#include <random>
+#include <string>
+
+#include "../common/class-bint.hpp"
+#include "../../include/deque.hpp"
+
+std::default_random_engine myRandom(8191);
+const int N = 50000;
+
+class Tracked
+{
+public:
+	static long long copyCnt, moveCnt;
+	std::string payload;
+
+	Tracked(const std::string &s) : payload(s) {}
+	Tracked(const Tracked &rhs) : payload(rhs.payload) { ++copyCnt; }
+	Tracked(Tracked &&rhs) : payload(std::move(rhs.payload)) { ++moveCnt; }
+	Tracked& operator=(const Tracked &rhs) = delete;
+};
+
+long long Tracked::copyCnt = 0;
+long long Tracked::moveCnt = 0;
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+template<class T, class U>
+void check(sjtu::deque<T> &d, const std::deque<U> &s)
+{
+	if (d.size() != s.size())
+		error();
+
+	size_t i = 0;
+	for (auto it = d.begin(); it != d.end(); ++it, ++i)
+		if (!(it->payload == s[i]))
+			error();
+}
+
+void TestInsertOnlyMoves()
+{
+	std::cout << "Test 1 : Test for copies during push and random insert...";
+	Tracked::copyCnt = Tracked::moveCnt = 0;
+	sjtu::deque<Tracked> d;
+	std::deque<std::string> s;
+	long long handed = 0;
+	for (int i = 0; i < N; ++i) {
+		std::string v = std::to_string(myRandom()) + "-a-string-long-enough-to-be-on-heap";
+		Tracked t(v);
+		int op = myRandom() % 3;
+		if (op == 0) {
+			d.push_back(t);
+			s.push_back(v);
+		}
+		else if (op == 1) {
+			d.push_front(t);
+			s.push_front(v);
+		}
+		else {
+			size_t k = myRandom() % (s.size() + 1);
+			d.insert(d.begin() + k, t);
+			s.insert(s.begin() + k, v);
+		}
+		++handed;
+	}
+	check(d, s);
+	if (Tracked::copyCnt != handed || Tracked::moveCnt == 0)
+		error();
+	std::cout << "Correct. copies=" << Tracked::copyCnt << " moves=" << Tracked::moveCnt << std::endl;
+}
+
+void TestEraseOnlyMoves()
+{
+	std::cout << "Test 2 : Test for copies during random erase...";
+	sjtu::deque<Tracked> d;
+	std::deque<std::string> s;
+	for (int i = 0; i < N; ++i) {
+		std::string v = std::to_string(i) + "-another-string-long-enough-to-be-on-heap";
+		d.push_back(Tracked(v));
+		s.push_back(v);
+	}
+	Tracked::copyCnt = Tracked::moveCnt = 0;
+	for (int i = 0; i < N - 10; ++i) {
+		size_t k = myRandom() % s.size();
+		d.erase(d.begin() + k);
+		s.erase(s.begin() + k);
+	}
+	check(d, s);
+	if (Tracked::copyCnt != 0 || Tracked::moveCnt == 0)
+		error();
+	std::cout << "Correct. copies=" << Tracked::copyCnt << " moves=" << Tracked::moveCnt << std::endl;
+}
+
+void TestCopyConstructor()
+{
+	std::cout << "Test 3 : Test for copies made by copy constructor...";
+	sjtu::deque<Tracked> d;
+	for (int i = 0; i < N; ++i)
+		d.push_front(Tracked(std::to_string(i)));
+	Tracked::copyCnt = 0;
+	sjtu::deque<Tracked> e(d);
+	if (Tracked::copyCnt != N)
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+Util::Bint makeBint(long long i)
+{
+	return Util::Bint(i + (1LL << 50)) * Util::Bint(i + 17);
+}
+
+void TestBint()
+{
+	std::cout << "Test 4 : Test for big integer with random insert and erase...";
+	sjtu::deque<Util::Bint> d;
+	std::deque<long long> s;
+	for (long long i = 0; i < N; ++i) {
+		size_t k = myRandom() % (s.size() + 1);
+		d.insert(d.begin() + k, makeBint(i));
+		s.insert(s.begin() + k, i);
+		if (i % 3 == 0) {
+			k = myRandom() % s.size();
+			d.erase(d.begin() + k);
+			s.erase(s.begin() + k);
+		}
+	}
+	for (size_t i = 0; i < s.size(); ++i)
+		if (!(d[i] == makeBint(s[i])))
+			error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestTrivial()
+{
+	std::cout << "Test 5 : Test for trivially copyable elements relocated by memmove...";
+	sjtu::deque<long long> d;
+	std::deque<long long> s;
+	for (long long i = 0; i < 4 * N; ++i) {
+		size_t k = myRandom() % (s.size() + 1);
+		d.insert(d.begin() + k, i);
+		s.insert(s.begin() + k, i);
+		if (i % 4 == 0) {
+			k = myRandom() % s.size();
+			d.erase(d.begin() + k);
+			s.erase(s.begin() + k);
+		}
+	}
+	for (size_t i = 0; i < s.size(); ++i)
+		if (d[i] != s[i])
+			error();
+	std::cout << "Correct." << std::endl;
+}
+
+int main()
+{
+	TestInsertOnlyMoves();
+	TestEraseOnlyMoves();
+	TestCopyConstructor();
+	TestBint();
+	TestTrivial();
+	return 0;
+}
@@ -0,0 +1,123 @@
+//Test for the block size policies of sjtu::deque, checked against std::deque.
+#include <iostream>
+#include <deque>
+#include <random>
+#include <string>
+#include <ctime>
+
+#include "../../include/deque.hpp"
+
+std::default_random_engine myRandom(20180314);
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+template<class Deque>
+bool isEqual(const std::deque<std::string> &a, const Deque &b)
+{
+	if (a.size() != b.size())
+		return false;
+
+	size_t i = 0;
+	for (auto it = b.cbegin(); it != b.cend(); ++it, ++i)
+		if (*it != a[i])
+			return false;
+
+	return i == a.size();
+}
+
+//a policy asking for blocks of a single element, which are taken as blocks of two
+struct single_block_policy
+{
+	template<class T>
+	static size_t block_size(size_t)
+	{
+		return 1;
+	}
+};
+
+//tiny blocks make a deque of many blocks, so fewer operations are taken for them
+template<class Policy>
+void TestPolicy(const char *name, int n)
+{
+	std::cout << "Test for " << name << "...";
+	typedef sjtu::deque<std::string, Policy> Deque;
+	Deque d;
+	std::deque<std::string> s;
+	for (int i = 0; i < n; ++i) {
+		int op = myRandom() % 8;
+		std::string v = std::to_string(i);
+		if (op == 0) {
+			d.push_back(v);
+			s.push_back(v);
+		}
+		else if (op == 1) {
+			d.push_front(v);
+			s.push_front(v);
+		}
+		else if (op <= 3) {
+			size_t k = myRandom() % (s.size() + 1);
+			if (*d.insert(d.begin() + k, v) != v)
+				error();
+			s.insert(s.begin() + k, v);
+		}
+		else if (s.empty())
+			continue;
+		else if (op == 4) {
+			size_t k = myRandom() % s.size();
+			d.erase(d.begin() + k);
+			s.erase(s.begin() + k);
+		}
+		else if (op == 5) {
+			d.pop_front();
+			s.pop_front();
+		}
+		else if (op == 6) {
+			size_t k = myRandom() % s.size();
+			if (d[k] != s[k] || (d.begin() + k) - d.begin() != (int)k)
+				error();
+		}
+		else if (i % 50 == 7) {
+			size_t a = myRandom() % s.size(), b = a + myRandom() % 100;
+			if (b > s.size())
+				b = s.size();
+			d.erase(d.begin() + a, d.begin() + b);
+			if (a < b)
+				s.erase(s.begin() + a, s.begin() + b);
+			d.insert(d.begin() + a, 30, v);
+			s.insert(s.begin() + a, 30, v);
+		}
+	}
+	Deque copy(d), assign;
+	assign = copy;
+	if (!isEqual(s, d) || !isEqual(s, copy) || !isEqual(s, assign))
+		error();
+
+	clock_t start = clock();
+	sjtu::deque<int, Policy> speed;
+	for (int i = 0; i < 10 * n; ++i)
+		speed.push_back(i);
+	long long sum = 0;
+	for (int i = 0; i < 2 * n; ++i) {
+		speed.insert(speed.begin() + myRandom() % speed.size(), i);
+		speed.erase(speed.begin() + myRandom() % speed.size());
+		sum += speed[myRandom() % speed.size()];
+	}
+	std::cout << "Correct. (" << (double)(clock() - start) / CLOCKS_PER_SEC << "s)" << std::endl;
+	if (sum == -1)
+		std::cout << sum << std::endl;
+}
+
+int main()
+{
+	TestPolicy<sjtu::sqrt_block_policy>("sqrt_block_policy", 50000);
+	TestPolicy<sjtu::fixed_bytes_block_policy<4096> >("fixed_bytes_block_policy<4096>", 50000);
+	TestPolicy<sjtu::fixed_elements_block_policy<512> >("fixed_elements_block_policy<512>", 50000);
+	TestPolicy<sjtu::fixed_bytes_block_policy<256> >("fixed_bytes_block_policy<256>", 5000);
+	TestPolicy<sjtu::fixed_elements_block_policy<2> >("fixed_elements_block_policy<2>", 2000);
+	TestPolicy<single_block_policy>("a policy of single elements", 2000);
+	return 0;
+}
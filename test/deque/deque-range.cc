@@ -0,0 +1,199 @@
+//Test for the range insert and erase of sjtu::deque, checked against std::deque.
+#include <iostream>
+#include <deque>
+#include <list>
+#include <random>
+#include <sstream>
+#include <iterator>
+#include <string>
+#include <ctime>
+
+#include "../common/class-integer.hpp"
+#include "../../include/deque.hpp"
+
+std::default_random_engine myRandom(20180101);
+
+//inserting an empty range into the middle of std::deque corrupts it in libstdc++ 12,
+//so empty ranges are only inserted into sjtu::deque
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+template<class T>
+bool isEqual(const std::deque<T> &a, const sjtu::deque<T> &b)
+{
+	if (a.size() != b.size())
+		return false;
+
+	size_t i = 0;
+	for (auto it = b.cbegin(); it != b.cend(); ++it, ++i) {
+		T value(*it);//operator== of Integer is not const
+		if (!(value == a[i]))
+			return false;
+	}
+
+	return i == a.size();
+}
+
+void TestInsertRange()
+{
+	std::cout << "Test 1 : Test for insert(pos, first, last)...";
+	sjtu::deque<std::string> d;
+	std::deque<std::string> s;
+	for (int i = 0; i < 3000; ++i) {
+		std::list<std::string> range;
+		int len = myRandom() % 8 == 0 ? myRandom() % 3000 : myRandom() % 30;
+		for (int j = 0; j < len; ++j)
+			range.push_back(std::to_string(i) + "-" + std::to_string(j));
+		size_t k = myRandom() % (s.size() + 1);
+		if (len > 0)
+			s.insert(s.begin() + k, range.begin(), range.end());
+		auto it = d.insert(d.begin() + k, range.begin(), range.end());
+		if (it - d.begin() != (int)k || (len > 0 && *it != range.front()))
+			error();
+	}
+	if (!isEqual(s, d))
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestInsertFill()
+{
+	std::cout << "Test 2 : Test for insert(pos, n, value)...";
+	sjtu::deque<Integer> d;
+	std::deque<Integer> s;
+	for (int i = 0; i < 3000; ++i) {
+		size_t n = myRandom() % 50;
+		size_t k = myRandom() % (s.size() + 1);
+		if (n > 0)
+			s.insert(s.begin() + k, n, Integer(i));
+		d.insert(d.begin() + k, n, Integer(i));
+	}
+	if (!isEqual(s, d))
+		error();
+
+	//the value may be an element of the deque itself
+	sjtu::deque<int> dInt;
+	std::deque<int> sInt;
+	for (int i = 0; i < 1000; ++i) {
+		dInt.push_back(i);
+		sInt.push_back(i);
+	}
+	for (int i = 0; i < 1000; ++i) {
+		size_t k = myRandom() % sInt.size(), v = myRandom() % sInt.size();
+		int value = sInt[v];
+		sInt.insert(sInt.begin() + k, 3, value);
+		dInt.insert(dInt.begin() + k, 3, dInt[v]);
+	}
+	if (!isEqual(sInt, dInt))
+		error();
+
+	//and so may the value inserted alone, which then moves with the elements around it
+	sjtu::deque<std::string> dStr;
+	std::deque<std::string> sStr;
+	for (int i = 0; i < 3000; ++i) {
+		size_t k = myRandom() % (sStr.size() + 1), v = sStr.empty() ? 0 : myRandom() % sStr.size();
+		std::string value = sStr.empty() ? std::to_string(i) : sStr[v];
+		sStr.insert(sStr.begin() + k, value);
+		if (dStr.empty())
+			dStr.insert(dStr.begin(), value);
+		else
+			dStr.insert(dStr.begin() + k, dStr[v]);
+	}
+	if (!isEqual(sStr, dStr))
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestInputIterator()
+{
+	std::cout << "Test 3 : Test for single pass input iterators...";
+	sjtu::deque<int> d;
+	std::deque<int> s;
+	for (int i = 0; i < 300; ++i) {
+		std::ostringstream out;
+		int len = myRandom() % 500;
+		for (int j = 0; j < len; ++j)
+			out << i * 1000 + j << ' ';
+		std::istringstream in1(out.str()), in2(out.str());
+		size_t k = myRandom() % (s.size() + 1);
+		if (len > 0)
+			s.insert(s.begin() + k, std::istream_iterator<int>(in1), std::istream_iterator<int>());
+		d.insert(d.begin() + k, std::istream_iterator<int>(in2), std::istream_iterator<int>());
+	}
+	if (!isEqual(s, d))
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestEraseRange()
+{
+	std::cout << "Test 4 : Test for erase(first, last)...";
+	sjtu::deque<std::string> d;
+	std::deque<std::string> s;
+	for (int i = 0; i < 200000; ++i) {
+		d.push_back(std::to_string(i));
+		s.push_back(std::to_string(i));
+	}
+	while (!s.empty()) {
+		size_t a = myRandom() % (s.size() + 1), b;
+		if (myRandom() % 2)
+			b = a + myRandom() % 10;
+		else
+			b = a + myRandom() % 5000;
+		if (b > s.size())
+			b = s.size();
+		if (a < b)
+			s.erase(s.begin() + a, s.begin() + b);
+		auto it = d.erase(d.begin() + a, d.begin() + b);
+		if (it - d.begin() != (int)a || (a < s.size() && *it != s[a]))
+			error();
+		if (myRandom() % 3 == 0) {
+			size_t k = myRandom() % (s.size() + 1);
+			s.insert(s.begin() + k, "x");
+			d.insert(d.begin() + k, "x");
+		}
+	}
+	if (!isEqual(s, d))
+		error();
+	try {
+		d.push_back("a");
+		d.push_back("b");
+		d.erase(d.end(), d.begin());
+		error();
+	} catch (...) {}
+	std::cout << "Correct." << std::endl;
+}
+
+void TestSplice()
+{
+	std::cout << "Test 5 : Test for speed of splicing 1000 records 2000 times...";
+	clock_t start = clock();
+	sjtu::deque<int> d;
+	std::deque<int> batch;
+	for (int i = 0; i < 1000; ++i)
+		batch.push_back(i);
+	for (int i = 0; i < 2000; ++i) {
+		d.insert(d.begin() + myRandom() % (d.size() + 1), batch.begin(), batch.end());
+		if (i % 2 == 0) {
+			size_t a = myRandom() % (d.size() - 500);
+			d.erase(d.begin() + a, d.begin() + a + 500);
+		}
+	}
+	if (d.size() != 1500000)
+		error();
+	std::cout << "Correct. (" << (double)(clock() - start) / CLOCKS_PER_SEC << "s)" << std::endl;
+}
+
+int main()
+{
+	TestInsertRange();
+	TestInsertFill();
+	TestInputIterator();
+	TestEraseRange();
+	TestSplice();
+	return 0;
+}
@@ -0,0 +1,139 @@
+//Test for the d-ary heap, and the push and pop throughput of all the heaps.
+#include <iostream>
+#include <vector>
+#include <set>
+#include <string>
+#include <queue>
+#include <random>
+#include <functional>
+#include <ctime>
+
+#include "../../include/priority_queue.hpp"
+
+std::default_random_engine myRandom(20181024);
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+template<size_t D>
+void TestRandom()
+{
+	std::cout << "Test for random operations of a " << D << "-ary heap...";
+	typedef sjtu::priority_queue<std::string, std::less<std::string>, sjtu::dary_heap<std::string, std::less<std::string>, D> > Queue;
+	Queue pq, other;
+	std::multiset<std::string> s, t;
+	for (int i = 0; i < 100000; ++i) {
+		int op = myRandom() % 100;
+		if (op < 55) {
+			std::string v = std::to_string(myRandom() % 100000);
+			pq.push(v);
+			s.insert(v);
+		}
+		else if (op < 60) {
+			std::string v = std::to_string(myRandom() % 100000);
+			other.push(v);
+			t.insert(v);
+		}
+		else if (op < 95) {
+			if (!s.empty()) {
+				if (pq.top() != *s.rbegin())
+					error();
+				pq.pop();
+				s.erase(--s.end());
+			}
+		}
+		else if (op < 98) {
+			pq.merge(other);
+			s.insert(t.begin(), t.end());
+			t.clear();
+			if (!other.empty())
+				error();
+		}
+		else if (!s.empty()) {
+			//push the top again, which lives in the heap itself
+			pq.push(pq.top());
+			s.insert(*s.rbegin());
+		}
+		if (pq.size() != s.size() || (!s.empty() && pq.top() != *s.rbegin()))
+			error();
+	}
+
+	Queue copy(pq);
+	pq = copy;
+	while (!copy.empty()) {
+		if (copy.top() != *s.rbegin() || pq.top() != copy.top())
+			error();
+		copy.pop();
+		pq.pop();
+		s.erase(--s.end());
+	}
+	try {
+		copy.top();
+		error();
+	} catch (sjtu::container_is_empty &) {}
+	std::cout << "Correct." << std::endl;
+}
+
+//push n random integers, then pop them all, and push and pop in turn on a heap of n/2 elements
+template<class Queue>
+void TestSpeed(const char *name, const std::vector<int> &a, unsigned long long expected)
+{
+	clock_t start = clock();
+	Queue pq;
+	unsigned long long sum = 0;
+	for (size_t i = 0; i < a.size(); ++i)
+		pq.push(a[i]);
+	while (!pq.empty()) {
+		sum = sum * 31 + pq.top();
+		pq.pop();
+	}
+	for (size_t i = 0; i < a.size() / 2; ++i)
+		pq.push(a[i]);
+	for (size_t i = a.size() / 2; i < a.size(); ++i) {
+		pq.push(a[i]);
+		sum = sum * 31 + pq.top();
+		pq.pop();
+	}
+	if (sum != expected)
+		error();
+	std::cout << "    " << name << " : " << (double)(clock() - start) / CLOCKS_PER_SEC << "s" << std::endl;
+}
+
+int main()
+{
+	TestRandom<2>();
+	TestRandom<3>();
+	TestRandom<4>();
+	TestRandom<8>();
+
+	const int n = 1000000;
+	std::vector<int> a(n);
+	for (int i = 0; i < n; ++i)
+		a[i] = myRandom();
+	unsigned long long expected = 0;
+	std::priority_queue<int> ref;
+	for (int i = 0; i < n; ++i)
+		ref.push(a[i]);
+	while (!ref.empty()) {
+		expected = expected * 31 + ref.top();
+		ref.pop();
+	}
+	for (int i = 0; i < n / 2; ++i)
+		ref.push(a[i]);
+	for (int i = n / 2; i < n; ++i) {
+		ref.push(a[i]);
+		expected = expected * 31 + ref.top();
+		ref.pop();
+	}
+
+	std::cout << "Test for speed of pushing and popping 1,000,000 integers..." << std::endl;
+	TestSpeed<std::priority_queue<int> >("std::priority_queue", a, expected);
+	TestSpeed<sjtu::priority_queue<int, std::less<int>, sjtu::binary_heap<int> > >("binary_heap", a, expected);
+	TestSpeed<sjtu::priority_queue<int, std::less<int>, sjtu::dary_heap<int> > >("dary_heap with D = 4", a, expected);
+	TestSpeed<sjtu::priority_queue<int, std::less<int>, sjtu::dary_heap<int, std::less<int>, 8> > >("dary_heap with D = 8", a, expected);
+	TestSpeed<sjtu::priority_queue<int> >("fibonacci_heap", a, expected);
+	return 0;
+}
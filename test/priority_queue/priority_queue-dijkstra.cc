@@ -0,0 +1,203 @@
+//Test for the handles, decrease_key and erase of the fibonacci heap,
+//and Dijkstra with decrease_key against Dijkstra pushing duplicate entries.
+#include <iostream>
+#include <vector>
+#include <set>
+#include <queue>
+#include <random>
+#include <utility>
+#include <functional>
+#include <ctime>
+
+#include "../../include/priority_queue.hpp"
+
+std::default_random_engine myRandom(20181022);
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+void TestHandles()
+{
+	std::cout << "Test 1 : Test for random push, pop, decrease_key and erase...";
+	sjtu::priority_queue<long long> pq;
+	typedef sjtu::priority_queue<long long>::handle_type handle;
+	std::multiset<long long> s;
+	std::vector<handle> hs;//the handles still in the heap
+	for (int i = 0; i < 200000; ++i) {
+		int op = myRandom() % 10;
+		if (op < 4 || s.empty()) {
+			long long v = myRandom() % 1000000;
+			hs.push_back(pq.push(v));
+			s.insert(v);
+		}
+		else if (op < 7) {
+			size_t k = myRandom() % hs.size();
+			long long old = pq.get(hs[k]), v = old + myRandom() % 1000;
+			s.erase(s.find(old));
+			s.insert(v);
+			pq.decrease_key(hs[k], v);
+		}
+		else if (op < 9) {
+			size_t k = myRandom() % hs.size();
+			s.erase(s.find(pq.get(hs[k])));
+			pq.erase(hs[k]);
+			hs[k] = hs.back();
+			hs.pop_back();
+		}
+		else {
+			//pop the top and forget its handle
+			long long top = pq.top();
+			if (top != *s.rbegin())
+				error();
+			for (size_t k = 0; k < hs.size(); ++k)
+				if (pq.get(hs[k]) == top) {
+					pq.erase(hs[k]);
+					hs[k] = hs.back();
+					hs.pop_back();
+					break;
+				}
+			s.erase(--s.end());
+		}
+		if (pq.size() != s.size() || (!s.empty() && pq.top() != *s.rbegin()))
+			error();
+	}
+
+	//a worse key is refused
+	try {
+		pq.decrease_key(hs[0], pq.get(hs[0]) - 1);
+		error();
+	} catch (sjtu::runtime_error &) {}
+	while (!pq.empty()) {
+		if (pq.top() != *s.rbegin())
+			error();
+		s.erase(--s.end());
+		pq.pop();
+	}
+	std::cout << "Correct." << std::endl;
+}
+
+const int n = 20000;
+const int m = 2000000;
+
+struct Edge {
+	int v, w;
+	Edge(int _v, int _w) : v(_v), w(_w) {}
+};
+
+std::vector<std::vector<Edge> > to(n + 1);
+
+void ConstructGraph()
+{
+	std::uniform_int_distribution<int> vertex(1, n);
+	std::uniform_int_distribution<int> weight(1, 100000);
+	for (int i = 0; i < m; ++i) {
+		int u = vertex(myRandom), v = vertex(myRandom);
+		to[u].push_back(Edge(v, weight(myRandom)));
+	}
+}
+
+typedef std::pair<long long, int> State;//(distance, vertex)
+
+//one entry for each vertex, moved up by decrease_key
+template<class Queue>
+std::vector<long long> DijkstraWithHandles(size_t &maxSize)
+{
+	Queue pq;
+	std::vector<long long> dist(n + 1, -1);
+	std::vector<typename Queue::handle_type> where(n + 1);
+	std::vector<bool> queued(n + 1, false), done(n + 1, false);
+	dist[1] = 0;
+	where[1] = pq.push(State(0, 1));
+	queued[1] = true;
+	maxSize = 1;
+	while (!pq.empty()) {
+		int u = pq.top().second;
+		pq.pop();
+		done[u] = true;
+		for (const Edge &e : to[u]) {
+			if (done[e.v])
+				continue;
+			long long d = dist[u] + e.w;
+			if (!queued[e.v]) {
+				dist[e.v] = d;
+				where[e.v] = pq.push(State(d, e.v));
+				queued[e.v] = true;
+			}
+			else if (d < dist[e.v]) {
+				dist[e.v] = d;
+				pq.decrease_key(where[e.v], State(d, e.v));
+			}
+		}
+		maxSize = std::max(maxSize, pq.size());
+	}
+	return dist;
+}
+
+//pushes a new entry on every improvement and skips the stale ones, as test/list/list-dijkstra.cc does
+template<class Queue>
+std::vector<long long> DijkstraWithDuplicates(size_t &maxSize)
+{
+	Queue pq;
+	std::vector<long long> dist(n + 1, -1);
+	std::vector<bool> done(n + 1, false);
+	dist[1] = 0;
+	pq.push(State(0, 1));
+	maxSize = 1;
+	while (!pq.empty()) {
+		State s = pq.top();
+		pq.pop();
+		if (done[s.second])
+			continue;
+		done[s.second] = true;
+		for (const Edge &e : to[s.second]) {
+			long long d = s.first + e.w;
+			if (dist[e.v] < 0 || d < dist[e.v]) {
+				dist[e.v] = d;
+				pq.push(State(d, e.v));
+			}
+		}
+		maxSize = std::max(maxSize, pq.size());
+	}
+	return dist;
+}
+
+void TestDijkstra()
+{
+	std::cout << "Test 2 : Test for speed of Dijkstra with " << n << " vertices and " << m << " edges..." << std::endl;
+	ConstructGraph();
+	size_t maxSize;
+
+	clock_t start = clock();
+	std::vector<long long> expected = DijkstraWithDuplicates<std::priority_queue<State, std::vector<State>, std::greater<State> > >(maxSize);
+	std::cout << "    std::priority_queue with duplicates : " << (double)(clock() - start) / CLOCKS_PER_SEC
+		<< "s, at most " << maxSize << " entries" << std::endl;
+
+	start = clock();
+	if (DijkstraWithDuplicates<sjtu::priority_queue<State, std::greater<State> > >(maxSize) != expected)
+		error();
+	std::cout << "    sjtu::priority_queue with duplicates : " << (double)(clock() - start) / CLOCKS_PER_SEC
+		<< "s, at most " << maxSize << " entries" << std::endl;
+
+	start = clock();
+	if (DijkstraWithHandles<sjtu::priority_queue<State, std::greater<State> > >(maxSize) != expected)
+		error();
+	std::cout << "    sjtu::priority_queue with decrease_key : " << (double)(clock() - start) / CLOCKS_PER_SEC
+		<< "s, at most " << maxSize << " entries" << std::endl;
+
+	start = clock();
+	if (DijkstraWithHandles<sjtu::priority_queue<State, std::greater<State>, sjtu::pairing_heap<State, std::greater<State> > > >(maxSize) != expected)
+		error();
+	std::cout << "    pairing_heap with decrease_key : " << (double)(clock() - start) / CLOCKS_PER_SEC
+		<< "s, at most " << maxSize << " entries" << std::endl;
+}
+
+int main()
+{
+	TestHandles();
+	TestDijkstra();
+	std::cout << "Congratulations. Your priority queue has passed all correctness tests." << std::endl;
+	return 0;
+}
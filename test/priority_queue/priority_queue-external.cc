@@ -0,0 +1,162 @@
+//Test for sjtu::external_priority_queue with a tiny memory budget, and its speed against the queues in memory.
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <queue>
+#include <random>
+#include <functional>
+#include <ctime>
+
+#include "../../include/priority_queue.hpp"
+
+std::default_random_engine myRandom(20181101);
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+struct Event
+{
+	long long time;
+	int id;
+
+	bool operator<(const Event &rhs) const { return time < rhs.time || (time == rhs.time && id < rhs.id); }
+	bool operator>(const Event &rhs) const { return rhs < *this; }
+	bool operator!=(const Event &rhs) const { return time != rhs.time || id != rhs.id; }
+};
+
+//with 4KB of memory and blocks of 256 bytes, 2KB is for the insertion heap and 8 blocks for the runs,
+//of which 2 are for the run being written and the merge, so there are at most 6 runs and the rest is merged
+template<class Heap>
+void TestRandom(const char *name)
+{
+	std::cout << "Test for random push and pop with " << name << "...";
+	sjtu::external_priority_queue<Event, std::greater<Event>, Heap> q(4096, 256);
+	std::priority_queue<Event, std::vector<Event>, std::greater<Event> > s;
+	size_t most = 0;
+	for (int i = 0; i < 400000; ++i) {
+		int op = myRandom() % 100;
+		if (op < 55 || (op < 60 && i % 50000 < 20000)) {
+			Event e = { (long long)(myRandom() % 1000000), i };
+			q.push(e);
+			s.push(e);
+		}
+		else if (!s.empty()) {
+			if (q.top() != s.top())
+				error();
+			q.pop();
+			s.pop();
+		}
+		if (q.size() != s.size() || (!s.empty() && q.top() != s.top()))
+			error();
+		most = std::max(most, q.runs_on_disk());
+	}
+	if (most < 2 || most > 6)
+		error();
+	while (!s.empty()) {
+		if (q.top() != s.top())
+			error();
+		q.pop();
+		s.pop();
+	}
+	if (!q.empty() || q.runs_on_disk() != 0)
+		error();
+	try {
+		q.pop();
+		error();
+	} catch (sjtu::container_is_empty &) {}
+	try {
+		q.top();
+		error();
+	} catch (sjtu::container_is_empty &) {}
+	std::cout << "Correct." << std::endl;
+}
+
+//push all the numbers, then pop them all
+template<class Queue>
+void Sort(Queue &q, const std::vector<long long> &a, std::vector<long long> &out)
+{
+	for (size_t i = 0; i < a.size(); ++i)
+		q.push(a[i]);
+	for (size_t i = 0; i < a.size(); ++i) {
+		out[i] = q.top();
+		q.pop();
+	}
+}
+
+//the queue holds size events, and each pop schedules one more a random while later
+template<class Queue>
+unsigned long long Hold(Queue &q, size_t size, size_t rounds)
+{
+	std::default_random_engine r(1);
+	for (size_t i = 0; i < size; ++i)
+		q.push((long long)(r() % 1000000));
+	unsigned long long check = 0;
+	for (size_t i = 0; i < rounds; ++i) {
+		long long t = q.top();
+		q.pop();
+		check = check * 31 + t;
+		q.push(t + (long long)(r() % 1000000));
+	}
+	return check;
+}
+
+void TestSpeed()
+{
+	const size_t N = 10000000;
+	typedef std::greater<long long> Greater;
+	std::vector<long long> a(N), expected(N), out(N);
+	for (size_t i = 0; i < N; ++i)
+		a[i] = ((long long)myRandom() << 16) ^ myRandom();
+
+	std::cout << "Test for speed of pushing and popping 10,000,000 numbers (80MB), with 16MB of memory..." << std::endl;
+	clock_t start = clock();
+	{
+		sjtu::priority_queue<long long, Greater, sjtu::binary_heap<long long, Greater> > q;
+		Sort(q, a, expected);
+	}
+	std::cout << "    sjtu::priority_queue in memory : " << (double)(clock() - start) / CLOCKS_PER_SEC << "s" << std::endl;
+	start = clock();
+	{
+		sjtu::external_priority_queue<long long, Greater> q(16 << 20);
+		Sort(q, a, out);
+		if (out != expected)
+			error();
+	}
+	std::cout << "    external_priority_queue : " << (double)(clock() - start) / CLOCKS_PER_SEC << "s" << std::endl;
+	start = clock();
+	{
+		sjtu::external_priority_queue<long long, Greater, sjtu::dary_heap<long long, Greater> > q(16 << 20);
+		Sort(q, a, out);
+		if (out != expected)
+			error();
+	}
+	std::cout << "    external_priority_queue with dary_heap : " << (double)(clock() - start) / CLOCKS_PER_SEC << "s" << std::endl;
+
+	std::cout << "Test for speed of 10,000,000 events with 5,000,000 waiting, with 16MB of memory..." << std::endl;
+	start = clock();
+	unsigned long long check;
+	{
+		sjtu::priority_queue<long long, Greater, sjtu::binary_heap<long long, Greater> > q;
+		check = Hold(q, N / 2, N);
+	}
+	std::cout << "    sjtu::priority_queue in memory : " << (double)(clock() - start) / CLOCKS_PER_SEC << "s" << std::endl;
+	start = clock();
+	{
+		sjtu::external_priority_queue<long long, Greater> q(16 << 20);
+		if (Hold(q, N / 2, N) != check)
+			error();
+	}
+	std::cout << "    external_priority_queue : " << (double)(clock() - start) / CLOCKS_PER_SEC << "s" << std::endl;
+}
+
+int main()
+{
+	TestRandom<sjtu::binary_heap<Event, std::greater<Event> > >("binary_heap");
+	TestRandom<sjtu::dary_heap<Event, std::greater<Event> > >("dary_heap");
+	TestRandom<sjtu::pairing_heap<Event, std::greater<Event> > >("pairing_heap");
+	TestSpeed();
+	return 0;
+}
@@ -0,0 +1,221 @@
+//Test for indexed_priority_queue, and its speed in Dijkstra on the graph of test/list/list-dijkstra.cc.
+#include <iostream>
+#include <vector>
+#include <queue>
+#include <random>
+#include <utility>
+#include <functional>
+#include <ctime>
+
+#include "../../include/list.hpp"
+#include "../../include/priority_queue.hpp"
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+void TestRandom()
+{
+	std::cout << "Test for random push, pop, decrease_key, increase_key and erase...";
+	std::default_random_engine myRandom(20181027);
+	const int ids = 5000;
+	sjtu::indexed_priority_queue<int> pq(ids / 2);//the rest of the ids make it grow
+	std::vector<int> key(ids);
+	std::vector<bool> in(ids, false);
+	int count = 0;
+	for (int i = 0; i < 500000; ++i) {
+		int id = myRandom() % ids, op = myRandom() % 10, v = myRandom() % 100000;
+		if (pq.contains(id) != in[id])
+			error();
+		if (!in[id] && op < 4) {
+			pq.push(id, v);
+			key[id] = v;
+			in[id] = true;
+			++count;
+		}
+		else if (in[id] && op < 2) {
+			v = key[id] + v % 1000;
+			pq.decrease_key(id, v);
+			key[id] = v;
+		}
+		else if (in[id] && op < 4) {
+			v = key[id] - v % 1000;
+			pq.increase_key(id, v);
+			key[id] = v;
+		}
+		else if (in[id] && op < 5) {
+			pq.erase(id);
+			in[id] = false;
+			--count;
+		}
+		else if (op < 7 && count > 0) {
+			int top = pq.top_id();
+			if (!in[top] || pq.top() != key[top] || pq.get(top) != key[top])
+				error();
+			pq.pop();
+			in[top] = false;
+			--count;
+		}
+		if ((int)pq.size() != count)
+			error();
+	}
+
+	//the top is the greatest, and the errors are reported
+	int best = -1;
+	for (int id = 0; id < ids; ++id)
+		if (in[id] && (best < 0 || key[id] > key[best]))
+			best = id;
+	if (best >= 0 && pq.top() != key[best])
+		error();
+	try {
+		pq.push(best, 0);
+		error();
+	} catch (sjtu::runtime_error &) {}
+	try {
+		pq.decrease_key(best, key[best] - 1);
+		error();
+	} catch (sjtu::runtime_error &) {}
+	try {
+		pq.increase_key(best, key[best] + 1);
+		error();
+	} catch (sjtu::runtime_error &) {}
+	int absent = 0;
+	while (in[absent])
+		++absent;
+	try {
+		pq.erase(absent);
+		error();
+	} catch (sjtu::index_out_of_bound &) {}
+	try {
+		pq.get(ids * 2);
+		error();
+	} catch (sjtu::index_out_of_bound &) {}
+
+	int last = ~0U >> 1;
+	while (!pq.empty()) {
+		if (pq.top() > last || pq.top() != key[pq.top_id()])
+			error();
+		last = pq.top();
+		pq.pop();
+	}
+	try {
+		pq.pop();
+		error();
+	} catch (sjtu::container_is_empty &) {}
+	std::cout << "Correct." << std::endl;
+}
+
+//the same graph as test/list/list-dijkstra.cc
+std::default_random_engine myRandom(32421);
+
+const int n = 1000 + 5;
+const int m = 50000 + 5;
+typedef std::pair<int, int> Pair;
+
+struct Edge {
+	int v, w;
+	Edge(const int &_v, const int &_w) : v(_v), w(_w) {}
+};
+
+sjtu::list<Edge> to[n];
+int d[n];
+bool flag[n];
+
+void ConstructGraph()
+{
+	std::uniform_int_distribution<int> vertex(1, 100);
+	std::uniform_int_distribution<int> weight(5, 10000);
+	for (int i = 0; i < m; ++i) {
+		int u = vertex(myRandom);
+		int v;
+		do {
+			v = vertex(myRandom);
+		} while (u == v);
+		int w = weight(myRandom);
+		to[u].push_back(Edge(v, w));
+	}
+}
+
+//pushes a new entry on every improvement and skips the stale ones
+unsigned long long DijkstraWithDuplicates(int start)
+{
+	std::fill(d, d + n, ~0U >> 3);
+	std::fill(flag, flag + n, false);
+	d[start] = 0;
+	std::priority_queue<Pair, std::vector<Pair>, std::greater<Pair> > q;
+	q.push(std::make_pair(d[start], start));
+	while (!q.empty()) {
+		int x = q.top().second;
+		q.pop();
+		if (flag[x])
+			continue;
+		flag[x] = true;
+		for (sjtu::list<Edge>::iterator it = to[x].begin(); it != to[x].end(); ++it) {
+			if (it->w + d[x] < d[it->v]) {
+				d[it->v] = d[x] + it->w;
+				q.push(std::make_pair(d[it->v], it->v));
+			}
+		}
+	}
+	unsigned long long sum = 0;
+	for (int i = 1; i <= 100; ++i)
+		sum = sum * 7 + d[i];
+	return sum;
+}
+
+//one entry for each vertex
+unsigned long long DijkstraIndexed(int start, sjtu::indexed_priority_queue<int, std::greater<int> > &q)
+{
+	std::fill(d, d + n, ~0U >> 3);
+	std::fill(flag, flag + n, false);
+	d[start] = 0;
+	q.push(start, 0);
+	while (!q.empty()) {
+		int x = q.top_id();
+		q.pop();
+		flag[x] = true;
+		for (sjtu::list<Edge>::iterator it = to[x].begin(); it != to[x].end(); ++it) {
+			if (!flag[it->v] && it->w + d[x] < d[it->v]) {
+				d[it->v] = d[x] + it->w;
+				if (q.contains(it->v))
+					q.decrease_key(it->v, d[it->v]);
+				else
+					q.push(it->v, d[it->v]);
+			}
+		}
+	}
+	unsigned long long sum = 0;
+	for (int i = 1; i <= 100; ++i)
+		sum = sum * 7 + d[i];
+	return sum;
+}
+
+void TestDijkstra()
+{
+	std::cout << "Test for speed of Dijkstra from each of the 100 vertices 20 times..." << std::endl;
+	ConstructGraph();
+	std::vector<unsigned long long> expected(101);
+
+	clock_t start = clock();
+	for (int round = 0; round < 20; ++round)
+		for (int s = 1; s <= 100; ++s)
+			expected[s] = DijkstraWithDuplicates(s);
+	std::cout << "    std::priority_queue with duplicates : " << (double)(clock() - start) / CLOCKS_PER_SEC << "s" << std::endl;
+
+	start = clock();
+	sjtu::indexed_priority_queue<int, std::greater<int> > q(n);
+	for (int round = 0; round < 20; ++round)
+		for (int s = 1; s <= 100; ++s)
+			if (DijkstraIndexed(s, q) != expected[s])
+				error();
+	std::cout << "    indexed_priority_queue : " << (double)(clock() - start) / CLOCKS_PER_SEC << "s" << std::endl;
+}
+
+int main()
+{
+	TestRandom();
+	TestDijkstra();
+	return 0;
+}
@@ -0,0 +1,138 @@
+//Test for priority_queue::merge with both heaps, and its speed against popping one queue into the other.
+#include <iostream>
+#include <vector>
+#include <set>
+#include <random>
+#include <functional>
+#include <ctime>
+
+#include "../../include/priority_queue.hpp"
+
+std::default_random_engine myRandom(20181023);
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+template<class Queue>
+void TestMerge(const char *name)
+{
+	std::cout << "Test for random merges with " << name << "...";
+	const int k = 200;
+	std::vector<Queue> pq(k);
+	std::vector<std::multiset<int> > s(k);
+	for (int i = 0; i < 300000; ++i) {
+		int a = myRandom() % k, op = myRandom() % 100;
+		if (op < 60) {
+			int v = myRandom() % 1000000;
+			pq[a].push(v);
+			s[a].insert(v);
+		}
+		else if (op < 90) {
+			if (!s[a].empty()) {
+				if (pq[a].top() != *s[a].rbegin())
+					error();
+				pq[a].pop();
+				s[a].erase(--s[a].end());
+			}
+		}
+		else {
+			//a queue of any size, even an empty one or itself
+			int b = myRandom() % k;
+			pq[a].merge(pq[b]);
+			if (a != b) {
+				s[a].insert(s[b].begin(), s[b].end());
+				s[b].clear();
+			}
+			if (!pq[b].empty() && a != b)
+				error();
+		}
+		if (pq[a].size() != s[a].size() || (!s[a].empty() && pq[a].top() != *s[a].rbegin()))
+			error();
+	}
+	for (int a = 0; a < k; ++a) {
+		while (!pq[a].empty()) {
+			if (pq[a].top() != *s[a].rbegin())
+				error();
+			pq[a].pop();
+			s[a].erase(--s[a].end());
+		}
+	}
+	std::cout << "Correct." << std::endl;
+}
+
+void TestHandlesAfterMerge()
+{
+	std::cout << "Test for handles of a merged fibonacci heap...";
+	sjtu::priority_queue<int> a, b;
+	std::vector<sjtu::priority_queue<int>::handle_type> hs;
+	for (int i = 0; i < 1000; ++i) {
+		a.push(i);
+		hs.push_back(b.push(-i));
+	}
+	a.merge(b);
+	//b has given its nodes away, but can still be copied and refilled
+	sjtu::priority_queue<int> c(b);
+	b.push(-1);
+	if (!c.empty() || b.top() != -1)
+		error();
+	for (int i = 0; i < 1000; ++i)
+		a.decrease_key(hs[i], 5000 - i);
+	for (int i = 0; i < 1000; ++i) {
+		if (a.top() != 5000 - i)
+			error();
+		a.pop();
+	}
+	if (a.top() != 999 || a.size() != 1000)
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+template<class Queue>
+void TestSpeed(const char *name)
+{
+	const int n = 200000;
+	Queue a, b, c, d;
+	for (int i = 0; i < n; ++i) {
+		int v = myRandom();
+		a.push(v);
+		c.push(v);
+		v = myRandom();
+		b.push(v);
+		d.push(v);
+	}
+
+	clock_t start = clock();
+	a.merge(b);
+	double merged = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	start = clock();
+	while (!d.empty()) {
+		c.push(d.top());
+		d.pop();
+	}
+	double popped = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	while (!a.empty()) {
+		if (a.top() != c.top())
+			error();
+		a.pop();
+		c.pop();
+	}
+	std::cout << "    " << name << " : merge " << merged << "s, pop and push " << popped << "s" << std::endl;
+}
+
+int main()
+{
+	TestMerge<sjtu::priority_queue<int> >("fibonacci_heap");
+	TestMerge<sjtu::priority_queue<int, std::less<int>, sjtu::binary_heap<int> > >("binary_heap");
+	TestMerge<sjtu::priority_queue<int, std::less<int>, sjtu::pairing_heap<int> > >("pairing_heap");
+	TestHandlesAfterMerge();
+	std::cout << "Test for speed of combining two queues of 200,000 elements..." << std::endl;
+	TestSpeed<sjtu::priority_queue<int> >("fibonacci_heap");
+	TestSpeed<sjtu::priority_queue<int, std::less<int>, sjtu::binary_heap<int> > >("binary_heap");
+	TestSpeed<sjtu::priority_queue<int, std::less<int>, sjtu::pairing_heap<int> > >("pairing_heap");
+	return 0;
+}
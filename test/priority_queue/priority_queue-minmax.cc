@@ -0,0 +1,161 @@
+//Test for sjtu::minmax_heap, and its speed as a bounded scheduler against std::multiset.
+#include <iostream>
+#include <vector>
+#include <set>
+#include <string>
+#include <random>
+#include <functional>
+#include <ctime>
+
+#include "../../include/priority_queue.hpp"
+
+std::default_random_engine myRandom(20181030);
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+template<class T, class Compare, class Gen>
+void TestRandom(const char *name, Gen gen)
+{
+	std::cout << "Test for random operations with " << name << "...";
+	sjtu::minmax_heap<T, Compare> h, other;
+	std::multiset<T, Compare> s, t;
+	for (int i = 0; i < 300000; ++i) {
+		int op = myRandom() % 100;
+		if (op < 40) {
+			T v = gen();
+			h.push(v);
+			s.insert(v);
+		}
+		else if (op < 44) {
+			T v = gen();
+			other.push(v);
+			t.insert(v);
+		}
+		else if (op < 70) {
+			if (!s.empty()) {
+				if (h.min() != *s.begin())
+					error();
+				h.pop_min();
+				s.erase(s.begin());
+			}
+		}
+		else if (op < 96) {
+			if (!s.empty()) {
+				if (h.max() != *s.rbegin())
+					error();
+				h.pop_max();
+				s.erase(--s.end());
+			}
+		}
+		else if (op < 98) {
+			h.merge(other);
+			s.insert(t.begin(), t.end());
+			t.clear();
+			if (!other.empty())
+				error();
+		}
+		else {
+			std::vector<T> a;
+			for (int j = myRandom() % 30; j > 0; --j)
+				a.push_back(gen());
+			h.push_range(a.begin(), a.end());
+			s.insert(a.begin(), a.end());
+		}
+		if (h.size() != s.size() || (!s.empty() && (h.min() != *s.begin() || h.max() != *s.rbegin())))
+			error();
+	}
+
+	sjtu::minmax_heap<T, Compare> copy(h);
+	while (!copy.empty()) {
+		if (copy.min() != *s.begin() || copy.max() != *s.rbegin())
+			error();
+		if (s.size() % 2) {
+			copy.pop_min();
+			s.erase(s.begin());
+		}
+		else {
+			copy.pop_max();
+			s.erase(--s.end());
+		}
+	}
+	try {
+		copy.pop_max();
+		error();
+	} catch (sjtu::container_is_empty &) {}
+	std::cout << "Correct." << std::endl;
+}
+
+void TestQueue()
+{
+	std::cout << "Test for minmax_heap inside priority_queue...";
+	std::vector<int> a;
+	for (int i = 0; i < 100000; ++i)
+		a.push_back(myRandom() % 1000);
+	sjtu::priority_queue<int, std::less<int>, sjtu::minmax_heap<int> > pq(a.begin(), a.end());
+	std::multiset<int> s(a.begin(), a.end());
+	while (!pq.empty()) {
+		if (pq.top() != *s.rbegin())
+			error();
+		pq.pop();
+		s.erase(--s.end());
+	}
+	std::cout << "Correct." << std::endl;
+}
+
+//serve the best job now and then, and evict the worst one whenever there are more than cap waiting
+template<class Push, class Serve, class Evict, class Size>
+long long Schedule(const std::vector<int> &jobs, size_t cap, Push push, Serve serve, Evict evict, Size size)
+{
+	long long sum = 0;
+	for (size_t i = 0; i < jobs.size(); ++i) {
+		push(jobs[i]);
+		if (size() > cap)
+			sum -= evict();
+		if (i % 3 == 0)
+			sum += serve();
+	}
+	return sum;
+}
+
+void TestSpeed(const std::vector<int> &jobs, size_t cap)
+{
+	std::cout << "Test for speed of a scheduler of " << jobs.size() << " jobs keeping at most " << cap << "..." << std::endl;
+
+	clock_t start = clock();
+	std::multiset<int> s;
+	long long expected = Schedule(jobs, cap,
+		[&](int x) { s.insert(x); },
+		[&]() { int x = *s.rbegin(); s.erase(--s.end()); return x; },
+		[&]() { int x = *s.begin(); s.erase(s.begin()); return x; },
+		[&]() { return s.size(); });
+	std::cout << "    std::multiset : " << (double)(clock() - start) / CLOCKS_PER_SEC << "s" << std::endl;
+
+	start = clock();
+	sjtu::minmax_heap<int> h;
+	long long sum = Schedule(jobs, cap,
+		[&](int x) { h.push(x); },
+		[&]() { int x = h.max(); h.pop_max(); return x; },
+		[&]() { int x = h.min(); h.pop_min(); return x; },
+		[&]() { return h.size(); });
+	if (sum != expected)
+		error();
+	std::cout << "    minmax_heap : " << (double)(clock() - start) / CLOCKS_PER_SEC << "s" << std::endl;
+}
+
+int main()
+{
+	TestRandom<int, std::less<int> >("int", []() { return (int)(myRandom() % 100000); });
+	TestRandom<std::string, std::greater<std::string> >("string and greater", []() { return std::to_string(myRandom() % 100000); });
+	TestQueue();
+
+	std::vector<int> jobs(5000000);
+	for (size_t i = 0; i < jobs.size(); ++i)
+		jobs[i] = myRandom();
+	TestSpeed(jobs, 10000);
+	TestSpeed(jobs, 1000000);
+	return 0;
+}
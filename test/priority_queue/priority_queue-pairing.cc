@@ -0,0 +1,131 @@
+//Test for the pairing heap: push, pop, decrease_key, erase, merge and copy.
+#include <iostream>
+#include <vector>
+#include <set>
+#include <random>
+#include <functional>
+
+#include "../../include/priority_queue.hpp"
+
+std::default_random_engine myRandom(20181025);
+
+typedef sjtu::priority_queue<long long, std::less<long long>, sjtu::pairing_heap<long long> > Queue;
+typedef Queue::handle_type handle;
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+void TestHandles()
+{
+	std::cout << "Test 1 : Test for random push, pop, decrease_key, erase and merge...";
+	Queue pq, other;
+	std::multiset<long long> s, t;
+	std::vector<handle> hs, ht;//the handles still in pq and other
+	for (int i = 0; i < 300000; ++i) {
+		int op = myRandom() % 20;
+		if (op < 7 || s.empty()) {
+			long long v = myRandom() % 1000000;
+			hs.push_back(pq.push(v));
+			s.insert(v);
+		}
+		else if (op < 9) {
+			long long v = myRandom() % 1000000;
+			ht.push_back(other.push(v));
+			t.insert(v);
+		}
+		else if (op < 13) {
+			size_t k = myRandom() % hs.size();
+			long long old = pq.get(hs[k]), v = old + myRandom() % 1000;
+			s.erase(s.find(old));
+			s.insert(v);
+			pq.decrease_key(hs[k], v);
+		}
+		else if (op < 16) {
+			size_t k = myRandom() % hs.size();
+			s.erase(s.find(pq.get(hs[k])));
+			pq.erase(hs[k]);
+			hs[k] = hs.back();
+			hs.pop_back();
+		}
+		else if (op < 19) {
+			//pop the top and forget its handle
+			long long top = pq.top();
+			if (top != *s.rbegin())
+				error();
+			for (size_t k = 0; k < hs.size(); ++k)
+				if (pq.get(hs[k]) == top) {
+					pq.erase(hs[k]);
+					hs[k] = hs.back();
+					hs.pop_back();
+					break;
+				}
+			s.erase(--s.end());
+		}
+		else {
+			pq.merge(other);
+			s.insert(t.begin(), t.end());
+			hs.insert(hs.end(), ht.begin(), ht.end());
+			t.clear();
+			ht.clear();
+			if (!other.empty())
+				error();
+		}
+		if (pq.size() != s.size() || (!s.empty() && pq.top() != *s.rbegin()))
+			error();
+	}
+
+	//a worse key is refused
+	try {
+		pq.decrease_key(hs[0], pq.get(hs[0]) - 1);
+		error();
+	} catch (sjtu::runtime_error &) {}
+
+	//a copy has its own nodes
+	Queue copy(pq);
+	std::multiset<long long> cs(s);
+	long long old = pq.get(hs[0]);
+	pq.decrease_key(hs[0], 2000000);
+	s.erase(s.find(old));
+	s.insert(2000000);
+	while (!copy.empty()) {
+		if (copy.top() != *cs.rbegin())
+			error();
+		cs.erase(--cs.end());
+		copy.pop();
+	}
+	while (!pq.empty()) {
+		if (pq.top() != *s.rbegin())
+			error();
+		s.erase(--s.end());
+		pq.pop();
+	}
+	std::cout << "Correct." << std::endl;
+}
+
+void TestDeep()
+{
+	std::cout << "Test 2 : Test for copying and destroying a heap of 1,000,000 levels...";
+	//pushing keys in increasing order makes each new top the parent of the old one
+	Queue *pq = new Queue;
+	for (int i = 0; i < 1000000; ++i)
+		pq->push(i);
+	Queue copy(*pq);
+	delete pq;
+	for (int i = 999999; i >= 999000; --i) {
+		if (copy.top() != i)
+			error();
+		copy.pop();
+	}
+	std::cout << "Correct." << std::endl;
+}
+
+int main()
+{
+	TestHandles();
+	TestDeep();
+	std::cout << "Congratulations. Your pairing heap has passed all correctness tests." << std::endl;
+	return 0;
+}
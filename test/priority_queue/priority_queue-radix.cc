@@ -0,0 +1,180 @@
+//Test for the radix heap with monotone keys, and its speed in Dijkstra and an event simulation.
+#include <iostream>
+#include <vector>
+#include <set>
+#include <queue>
+#include <random>
+#include <utility>
+#include <functional>
+#include <ctime>
+
+#include "../../include/priority_queue.hpp"
+
+std::default_random_engine myRandom(20181026);
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+template<typename Key>
+void TestMonotone(const char *name, Key low)
+{
+	std::cout << "Test for random monotone operations with " << name << " keys...";
+	typedef std::pair<Key, int> Elem;
+	typedef sjtu::priority_queue<Elem, std::greater<Elem>, sjtu::radix_heap<Key, int> > Queue;
+	Queue pq, other;
+	std::multiset<Key> s, t;
+	Key last = low;
+	for (int i = 0; i < 300000; ++i) {
+		int op = myRandom() % 100;
+		if (op < 50) {
+			Key k = last + (Key)(myRandom() % (op < 5 ? 1000000000 : 1000));
+			pq.push(Elem(k, i));
+			s.insert(k);
+		}
+		else if (op < 55) {
+			Key k = last + (Key)(myRandom() % 100000);
+			other.push(Elem(k, i));
+			t.insert(k);
+		}
+		else if (op < 95) {
+			if (!s.empty()) {
+				if (pq.top().first != *s.begin())
+					error();
+				last = pq.top().first;
+				pq.pop();
+				s.erase(s.begin());
+			}
+		}
+		else if (t.empty() || *t.begin() >= last) {
+			pq.merge(other);
+			s.insert(t.begin(), t.end());
+			t.clear();
+			if (!other.empty())
+				error();
+		}
+		if (pq.size() != s.size() || (!s.empty() && pq.top().first != *s.begin()))
+			error();
+		if (!s.empty())
+			last = *s.begin();//top has been taken, so nothing less can be pushed
+	}
+
+	//a key less than the top is refused
+	if (!s.empty() && *s.begin() > low) {
+		try {
+			pq.push(Elem(*s.begin() - 1, 0));
+			error();
+		} catch (sjtu::runtime_error &) {}
+	}
+	size_t size = pq.size();
+	Queue copy(pq);
+	while (!copy.empty()) {
+		if (copy.top().first != *s.begin())
+			error();
+		copy.pop();
+		s.erase(s.begin());
+	}
+	if (pq.size() != size || pq.top().first != last)
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+const int n = 200000;
+const int m = 2000000;
+
+struct Edge {
+	int v, w;
+	Edge(int _v, int _w) : v(_v), w(_w) {}
+};
+
+std::vector<std::vector<Edge> > to(n + 1);
+
+void ConstructGraph()
+{
+	std::uniform_int_distribution<int> vertex(1, n);
+	std::uniform_int_distribution<int> weight(1, 100000);
+	for (int i = 0; i < m; ++i) {
+		int u = vertex(myRandom), v = vertex(myRandom);
+		to[u].push_back(Edge(v, weight(myRandom)));
+	}
+}
+
+typedef std::pair<unsigned long long, int> State;//(distance, vertex)
+
+//pushes a new entry on every improvement and skips the stale ones, as test/list/list-dijkstra.cc does
+template<class Queue>
+std::vector<unsigned long long> Dijkstra()
+{
+	Queue pq;
+	std::vector<unsigned long long> dist(n + 1, ~0ULL);
+	std::vector<bool> done(n + 1, false);
+	dist[1] = 0;
+	pq.push(State(0, 1));
+	while (!pq.empty()) {
+		State s = pq.top();
+		pq.pop();
+		if (done[s.second])
+			continue;
+		done[s.second] = true;
+		for (const Edge &e : to[s.second]) {
+			unsigned long long d = s.first + e.w;
+			if (d < dist[e.v]) {
+				dist[e.v] = d;
+				pq.push(State(d, e.v));
+			}
+		}
+	}
+	return dist;
+}
+
+//each event at time t schedules another one a random while later, until 5,000,000 events have happened
+template<class Queue>
+unsigned long long Simulate()
+{
+	std::default_random_engine r(1);
+	Queue pq;
+	for (int i = 0; i < 10000; ++i)
+		pq.push(State(r() % 1000, i));
+	unsigned long long check = 0;
+	for (int i = 0; i < 5000000; ++i) {
+		State s = pq.top();
+		pq.pop();
+		check = check * 31 + s.first;
+		pq.push(State(s.first + r() % 1000, s.second));
+	}
+	return check;
+}
+
+template<class Queue>
+void TestSpeed(const char *name, const std::vector<unsigned long long> &dist, unsigned long long check)
+{
+	clock_t start = clock();
+	if (Dijkstra<Queue>() != dist)
+		error();
+	double dijkstra = (double)(clock() - start) / CLOCKS_PER_SEC;
+	start = clock();
+	if (Simulate<Queue>() != check)
+		error();
+	std::cout << "    " << name << " : Dijkstra " << dijkstra << "s, simulation "
+		<< (double)(clock() - start) / CLOCKS_PER_SEC << "s" << std::endl;
+}
+
+int main()
+{
+	TestMonotone<unsigned>("unsigned", 0);
+	TestMonotone<long long>("signed", -2000000000000LL);
+
+	ConstructGraph();
+	typedef std::priority_queue<State, std::vector<State>, std::greater<State> > StdQueue;
+	std::vector<unsigned long long> dist = Dijkstra<StdQueue>();
+	unsigned long long check = Simulate<StdQueue>();
+
+	std::cout << "Test for speed of Dijkstra with " << n << " vertices and " << m << " edges, and 5,000,000 events..." << std::endl;
+	TestSpeed<StdQueue>("std::priority_queue", dist, check);
+	TestSpeed<sjtu::priority_queue<State, std::greater<State>, sjtu::binary_heap<State, std::greater<State> > > >("binary_heap", dist, check);
+	TestSpeed<sjtu::priority_queue<State, std::greater<State>, sjtu::dary_heap<State, std::greater<State> > > >("dary_heap", dist, check);
+	TestSpeed<sjtu::priority_queue<State, std::greater<State>, sjtu::radix_heap<unsigned long long, int> > >("radix_heap", dist, check);
+	return 0;
+}
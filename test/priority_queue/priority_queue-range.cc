@@ -0,0 +1,147 @@
+//Test for the range constructor and push_range of priority_queue with all the heaps,
+//and the speed of building a queue at once against pushing the elements one by one.
+#include <iostream>
+#include <vector>
+#include <list>
+#include <string>
+#include <algorithm>
+#include <random>
+#include <utility>
+#include <functional>
+#include <ctime>
+
+#include "../../include/list.hpp"
+#include "../../include/priority_queue.hpp"
+
+std::default_random_engine myRandom(20181028);
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+//pop all the elements, which must come out as expected sorted from the greatest
+template<class Queue, class T>
+void check(Queue &pq, std::vector<T> expected)
+{
+	std::sort(expected.begin(), expected.end());
+	if (pq.size() != expected.size())
+		error();
+	while (!pq.empty()) {
+		if (pq.top() != expected.back())
+			error();
+		pq.pop();
+		expected.pop_back();
+	}
+}
+
+template<class Queue>
+void TestRange(const char *name)
+{
+	std::cout << "Test for push_range with " << name << "...";
+	for (int round = 0; round < 120; ++round) {
+		std::vector<std::string> a;
+		int size = round < 60 ? round : myRandom() % 20000;
+		for (int i = 0; i < size; ++i)
+			a.push_back(std::to_string(myRandom() % 10000));
+
+		//random access iterators
+		Queue pq(a.begin(), a.end());
+		Queue copy(pq);
+		check(pq, a);
+
+		//input iterators of lists, into a queue which is not empty, in small and large pieces
+		std::list<std::string> l(a.begin(), a.end());
+		sjtu::list<std::string> sl;
+		std::vector<std::string> all(a);
+		for (int i = 0; i < size / 3; ++i) {
+			sl.push_back(std::to_string(myRandom() % 10000));
+			all.push_back(sl.back());
+		}
+		copy.push_range(l.begin(), l.end());
+		copy.push_range(sl.begin(), sl.end());
+		copy.push_range(l.begin(), l.begin());
+		all.insert(all.end(), a.begin(), a.end());
+		check(copy, all);
+	}
+	std::cout << "Correct." << std::endl;
+}
+
+void TestRadix()
+{
+	std::cout << "Test for push_range with radix_heap...";
+	typedef std::pair<unsigned, int> Elem;
+	std::vector<Elem> a;
+	for (int i = 0; i < 100000; ++i)
+		a.push_back(Elem(myRandom() % 1000000, i));
+	sjtu::priority_queue<Elem, std::greater<Elem>, sjtu::radix_heap<unsigned, int> > pq(a.begin(), a.end());
+	std::sort(a.begin(), a.end());
+	for (int i = 0; i < 50000; ++i) {
+		if (pq.top().first != a[i].first)
+			error();
+		pq.pop();
+	}
+	//the keys less than the last top are refused
+	try {
+		pq.push_range(a.begin(), a.end());
+		error();
+	} catch (sjtu::runtime_error &) {}
+	std::cout << "Correct." << std::endl;
+}
+
+//the first pop is timed as well, since the lazy heaps leave their work to it
+template<class Queue>
+void TestSpeed(const char *name, const std::vector<int> &a)
+{
+	clock_t start = clock();
+	Queue one;
+	for (size_t i = 0; i < a.size(); ++i)
+		one.push(a[i]);
+	int top = one.top();
+	one.pop();
+	double pushed = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	start = clock();
+	Queue all(a.begin(), a.end());
+	if (all.top() != top)
+		error();
+	all.pop();
+	double built = (double)(clock() - start) / CLOCKS_PER_SEC;
+
+	for (int i = 0; i < 1000; ++i) {
+		if (one.top() != all.top())
+			error();
+		one.pop();
+		all.pop();
+	}
+	std::cout << "    " << name << " : push one by one " << pushed << "s, build at once " << built << "s" << std::endl;
+}
+
+int main()
+{
+	TestRange<sjtu::priority_queue<std::string, std::less<std::string>, sjtu::binary_heap<std::string> > >("binary_heap");
+	TestRange<sjtu::priority_queue<std::string, std::less<std::string>, sjtu::dary_heap<std::string> > >("dary_heap");
+	TestRange<sjtu::priority_queue<std::string> >("fibonacci_heap");
+	TestRange<sjtu::priority_queue<std::string, std::less<std::string>, sjtu::pairing_heap<std::string> > >("pairing_heap");
+	TestRadix();
+
+	//ascending input is the worst case for pushing one by one into an array heap
+	const int n = 2000000;
+	std::vector<int> a(n);
+	for (int i = 0; i < n; ++i)
+		a[i] = myRandom() % 1000 + i * 100;
+	std::cout << "Test for speed of building a queue of 2,000,000 ascending integers..." << std::endl;
+	TestSpeed<sjtu::priority_queue<int, std::less<int>, sjtu::binary_heap<int> > >("binary_heap", a);
+	TestSpeed<sjtu::priority_queue<int, std::less<int>, sjtu::dary_heap<int> > >("dary_heap", a);
+	TestSpeed<sjtu::priority_queue<int> >("fibonacci_heap", a);
+	TestSpeed<sjtu::priority_queue<int, std::less<int>, sjtu::pairing_heap<int> > >("pairing_heap", a);
+
+	std::shuffle(a.begin(), a.end(), myRandom);
+	std::cout << "Test for speed of building a queue of 2,000,000 random integers..." << std::endl;
+	TestSpeed<sjtu::priority_queue<int, std::less<int>, sjtu::binary_heap<int> > >("binary_heap", a);
+	TestSpeed<sjtu::priority_queue<int, std::less<int>, sjtu::dary_heap<int> > >("dary_heap", a);
+	TestSpeed<sjtu::priority_queue<int> >("fibonacci_heap", a);
+	TestSpeed<sjtu::priority_queue<int, std::less<int>, sjtu::pairing_heap<int> > >("pairing_heap", a);
+	return 0;
+}
@@ -0,0 +1,116 @@
+//Test for sjtu::topk, and its speed against pushing a whole stream into a priority_queue.
+#include <iostream>
+#include <vector>
+#include <list>
+#include <string>
+#include <algorithm>
+#include <random>
+#include <functional>
+#include <ctime>
+
+#include "../../include/priority_queue.hpp"
+
+std::default_random_engine myRandom(20181029);
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+//the best k of a, the best first
+template<class T, class Compare>
+std::vector<T> expected(std::vector<T> a, size_t k, Compare cmp)
+{
+	std::sort(a.begin(), a.end(), [&](const T &x, const T &y) { return cmp(y, x); });
+	a.resize(std::min(k, a.size()));
+	return a;
+}
+
+template<class T, class Compare>
+void same(sjtu::topk<T, Compare> &t, const std::vector<T> &want)
+{
+	sjtu::vector<T> got = t.sorted_result();
+	if (got.size() != want.size() || !t.empty())
+		error();
+	for (size_t i = 0; i < want.size(); ++i)
+		if (got[i] != want[i])
+			error();
+}
+
+template<class T, class Compare, class Gen>
+void TestRandom(const char *name, Gen gen)
+{
+	std::cout << "Test for offer and offer_range with " << name << "...";
+	Compare cmp;
+	for (int round = 0; round < 300; ++round) {
+		size_t k = round < 50 ? round : myRandom() % 1000;
+		std::vector<T> a;
+		int size = round < 100 ? myRandom() % 100 : myRandom() % 50000;
+		for (int i = 0; i < size; ++i)
+			a.push_back(gen());
+		std::vector<T> want = expected(a, k, cmp);
+
+		sjtu::topk<T, Compare> one(k), range(k), list(k);
+		for (size_t i = 0; i < a.size(); ++i)
+			one.offer(a[i]);
+		if (one.size() != want.size() || (k > 0 && !a.empty() && one.threshold() != want.back()))
+			error();
+		sjtu::topk<T, Compare> copy(one);
+		same(one, want);
+		same(copy, want);
+
+		//in pieces, through pointers and through an input iterator
+		size_t mid = a.size() / 3;
+		range.offer_range(a.data(), a.data() + mid);
+		range.offer_range((const T *)a.data() + mid, (const T *)a.data() + a.size());
+		same(range, want);
+		std::list<T> l(a.begin(), a.end());
+		list.offer_range(l.begin(), l.end());
+		same(list, want);
+	}
+	std::cout << "Correct." << std::endl;
+}
+
+template<class T>
+void TestSpeed(const std::vector<T> &a, size_t k)
+{
+	std::cout << "Test for speed of keeping the best " << k << " of " << a.size() << " elements..." << std::endl;
+	std::vector<T> want = expected(a, k, std::less<T>());
+
+	clock_t start = clock();
+	sjtu::priority_queue<T, std::less<T>, sjtu::binary_heap<T> > pq(a.begin(), a.end());
+	for (size_t i = 0; i < k; ++i) {
+		if (pq.top() != want[i])
+			error();
+		pq.pop();
+	}
+	std::cout << "    priority_queue and pop " << k << " : " << (double)(clock() - start) / CLOCKS_PER_SEC << "s" << std::endl;
+
+	start = clock();
+	sjtu::topk<T> one(k);
+	for (size_t i = 0; i < a.size(); ++i)
+		one.offer(a[i]);
+	same(one, want);
+	std::cout << "    topk with offer : " << (double)(clock() - start) / CLOCKS_PER_SEC << "s" << std::endl;
+
+	start = clock();
+	sjtu::topk<T> range(k);
+	range.offer_range(a.data(), a.data() + a.size());
+	same(range, want);
+	std::cout << "    topk with offer_range : " << (double)(clock() - start) / CLOCKS_PER_SEC << "s" << std::endl;
+}
+
+int main()
+{
+	TestRandom<int, std::less<int> >("int", []() { return (int)(myRandom() % 100000); });
+	TestRandom<double, std::greater<double> >("double and greater", []() { return (double)myRandom() / 7; });
+	TestRandom<std::string, std::less<std::string> >("string", []() { return std::to_string(myRandom() % 100000); });
+
+	std::vector<float> a(10000000);
+	std::uniform_real_distribution<float> real(0, 1);
+	for (size_t i = 0; i < a.size(); ++i)
+		a[i] = real(myRandom);
+	TestSpeed(a, 100);
+	return 0;
+}
@@ -0,0 +1,180 @@
+//Test for emplace, move and the bulk operations of sjtu::stack and sjtu::queue,
+//and their speed in SPFA on a large graph and with many short-lived adapters.
+#include <iostream>
+#include <vector>
+#include <string>
+#include <random>
+#include <ctime>
+
+#include "../../include/list.hpp"
+#include "../../include/stack.hpp"
+#include "../../include/queue.hpp"
+
+std::default_random_engine myRandom(20181021);
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+struct Edge {
+	int v, w;
+	Edge(const int &_v, const int &_w) : v(_v), w(_w) {}
+};
+
+template<class Stack, class Queue>
+void TestInterface(const char *name)
+{
+	std::cout << "Test for emplace, move and bulk operations with " << name << "...";
+	Stack s;
+	Queue q;
+	for (int i = 0; i < 1000; ++i) {
+		std::string str = std::to_string(i);
+		s.emplace(3, 'a' + i % 26);
+		s.push(std::move(str));
+		q.emplace(str.empty() ? "moved" : "kept");
+		q.push(std::to_string(i));
+	}
+	if (s.size() != 2000 || s.top() != "999" || q.front() != "moved")
+		error();
+
+	Stack s2(std::move(s));
+	Queue q2(std::move(q));
+	if (!s.empty() || !q.empty() || s2.size() != 2000 || q2.size() != 2000)
+		error();
+	s = std::move(s2);
+	q = std::move(q2);
+	s.push("x");
+	q.push("x");
+	if (s.size() != 2001 || q.size() != 2001)
+		error();
+
+	std::vector<std::string> out(3000);
+	if (s.pop_bulk(out.begin(), 3) != 3 || out[0] != "x" || out[1] != "999" || out[2] != std::string(3, 'a' + 999 % 26))
+		error();
+	if (q.pop_bulk(out.begin(), 3) != 3 || out[0] != "moved" || out[1] != "0" || out[2] != "moved")
+		error();
+	if (s.pop_bulk(out.begin(), 3000) != 1998 || !s.empty() || q.pop_bulk(out.begin(), 3000) != 1998 || !q.empty())
+		error();
+	if (out[1997] != "x" || s.pop_bulk(out.begin(), 1) != 0)
+		error();
+
+	std::vector<std::string> in;
+	for (int i = 0; i < 100; ++i)
+		in.push_back(std::to_string(i));
+	s.push_bulk(in.begin(), in.end());
+	q.push_bulk(in.begin(), in.end());
+	if (s.top() != "99" || q.front() != "0" || s.size() != 100 || q.size() != 100)
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+int n;
+std::vector<std::vector<Edge> > to;
+std::vector<int> dist;
+std::vector<bool> inQueue;
+
+void ConstructGraph(int _n, int m)
+{
+	n = _n;
+	to.assign(n + 1, std::vector<Edge>());
+	dist.resize(n + 1);
+	inQueue.resize(n + 1);
+	std::uniform_int_distribution<int> vertex(1, n);
+	std::uniform_int_distribution<int> weight(5, 10000);
+	for (int i = 0; i < m; ++i) {
+		int u = vertex(myRandom), v = vertex(myRandom);
+		if (u != v)
+			to[u].push_back(Edge(v, weight(myRandom)));
+	}
+}
+
+//the queue is taken as a template, so that sjtu::stack fits in with top instead of front
+template<class Container, class Front>
+long long Spfa(Container &que, Front front)
+{
+	std::fill(dist.begin(), dist.end(), ~0U >> 3);
+	std::fill(inQueue.begin(), inQueue.end(), false);
+	dist[1] = 0;
+	inQueue[1] = true;
+	que.push(1);
+	while (!que.empty()) {
+		int u = front(que);
+		inQueue[u] = false;
+		que.pop();
+		for (const Edge &e : to[u]) {
+			if (dist[u] + e.w < dist[e.v]) {
+				dist[e.v] = dist[u] + e.w;
+				if (!inQueue[e.v]) {
+					que.push(e.v);
+					inQueue[e.v] = true;
+				}
+			}
+		}
+	}
+	long long sum = 0;
+	for (int i = 1; i <= n; ++i)
+		sum += dist[i];
+	return sum;
+}
+
+template<class Container, class Front>
+void TestSpfa(const char *name, Front front, long long expected, int rounds)
+{
+	clock_t start = clock();
+	for (int i = 0; i < rounds; ++i) {
+		Container que;
+		if (Spfa(que, front) != expected)
+			error();
+	}
+	std::cout << "    " << name << " : " << (double)(clock() - start) / CLOCKS_PER_SEC << "s" << std::endl;
+}
+
+//push and pop a few elements through each of 2,000,000 temporary adapters
+template<class Container>
+void TestShortLived(const char *name)
+{
+	clock_t start = clock();
+	long long sum = 0;
+	for (int i = 0; i < 2000000; ++i) {
+		Container c;
+		c.push(i);
+		c.push(i + 1);
+		sum += c.size();
+		c.pop();
+	}
+	if (sum != 4000000)
+		error();
+	std::cout << "    " << name << " : " << (double)(clock() - start) / CLOCKS_PER_SEC << "s" << std::endl;
+}
+
+int main()
+{
+	TestInterface<sjtu::stack<std::string>, sjtu::queue<std::string> >("vector and ring_buffer");
+	TestInterface<sjtu::stack<std::string, sjtu::list<std::string> >, sjtu::queue<std::string, sjtu::list<std::string> > >("list");
+
+	auto queueFront = [](sjtu::queue<int> &q) { return q.front(); };
+	auto listFront = [](sjtu::queue<int, sjtu::list<int> > &q) { return q.front(); };
+	auto stackTop = [](sjtu::stack<int> &s) { return s.top(); };
+	sjtu::queue<int> reference;
+
+	ConstructGraph(200000, 2000000);
+	long long expected = Spfa(reference, queueFront);
+	std::cout << "Test for speed of SPFA with 200,000 vertices and 2,000,000 edges..." << std::endl;
+	TestSpfa<sjtu::queue<int> >("queue", queueFront, expected, 5);
+	TestSpfa<sjtu::queue<int, sjtu::list<int> > >("queue on list", listFront, expected, 5);
+
+	//SPFA with a stack revisits the vertices too often for a big graph
+	ConstructGraph(1000, 10000);
+	expected = Spfa(reference, queueFront);
+	std::cout << "Test for speed of SPFA 100 times with 1,000 vertices and 10,000 edges..." << std::endl;
+	TestSpfa<sjtu::queue<int> >("queue", queueFront, expected, 100);
+	TestSpfa<sjtu::stack<int> >("stack", stackTop, expected, 100);
+
+	std::cout << "Test for speed of 2,000,000 short-lived adapters..." << std::endl;
+	TestShortLived<sjtu::queue<int> >("queue");
+	TestShortLived<sjtu::stack<int> >("stack");
+	TestShortLived<sjtu::stack<int, sjtu::list<int> > >("stack on list");
+	return 0;
+}
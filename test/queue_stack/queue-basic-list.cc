@@ -0,0 +1,44 @@
+#include <iostream>
+#include <queue>
+
+#include "../../include/queue.hpp"
+#include "../../include/list.hpp"
+#include "../common/class-bint.hpp"
+
+sjtu::queue<int, sjtu::list<int>> queInt;
+sjtu::queue<Util::Bint, sjtu::list<Util::Bint>> queBint;
+
+int main()
+{
+	for (int i = 1; i <= 100; ++i) {
+		queInt.push(i);
+		queBint.push(Util::Bint(i));
+	}
+	sjtu::queue<Util::Bint, sjtu::list<Util::Bint>> duplicateQueBint(queBint);
+	sjtu::queue<int, sjtu::list<int>> duplicateQueInt;
+	duplicateQueInt = queInt;
+	std::cout << "a queue for int" << std::endl; 
+	while (!queInt.empty()) {
+		std::cout << queInt.front() << " ";
+		queInt.pop();
+	}
+	std::cout << std::endl;
+	std::cout << "a queue for bint" << std::endl;
+	while (!queBint.empty()) {
+		std::cout << queBint.front() << " ";
+		queBint.pop();
+	}
+	std::cout << std::endl;
+	std::cout << "a queue for int" << std::endl; 
+	while (!duplicateQueInt.empty()) {
+		std::cout << duplicateQueInt.front() << " ";
+		duplicateQueInt.pop();
+	}
+	std::cout << std::endl;
+	std::cout << "a queue for bint" << std::endl;
+	while (!duplicateQueBint.empty()) {
+		std::cout << duplicateQueBint.front() << " ";
+		duplicateQueBint.pop();
+	}
+	std::cout << std::endl;
+}
\ No newline at end of file
@@ -0,0 +1,316 @@
+//Correctness and speed test for sjtu::rope, checked against std::vector.
+#include <iostream>
+#include <vector>
+#include <deque>
+#include <random>
+#include <string>
+#include <ctime>
+
+#include "../common/class-bint.hpp"
+#include "../common/class-integer.hpp"
+#include "../../include/rope.hpp"
+
+std::default_random_engine myRandom(20171217);
+const int N = 100005;
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+template<class Seq, class T>
+bool isEqual(const Seq &a, const sjtu::rope<T> &b)
+{
+	if (a.size() != b.size())
+		return false;
+
+	size_t i = 0;
+	for (auto it = b.cbegin(); it != b.cend(); ++it, ++i)
+		if (!(*it == a[i]))
+			return false;
+
+	return i == a.size();
+}
+
+void TestInteger()
+{
+	std::cout << "Test 1 : Test for classes without default constructor...";
+	sjtu::rope<Integer> rInt;
+	std::vector<Integer> vInt;
+	for (int i = 0; i < N; ++i) {
+		vInt.push_back(Integer(i));
+		rInt.push_back(Integer(i));
+	}
+	for (int i = 0; i < N; ++i) {
+		if (!(vInt[i] == rInt[i]))
+			error();
+	}
+	std::cout << "Correct." << std::endl;
+}
+
+void TestPushAndPop()
+{
+	std::cout << "Test 2 : Test for push and pop at both ends...";
+	sjtu::rope<Util::Bint> rBint;
+	std::deque<Util::Bint> vBint;
+	for (long long i = 0; i < N; ++i) {
+		Util::Bint v = Util::Bint(i + (1LL << 50)) * Util::Bint(i % 1007);
+		if (i & 1) {
+			rBint.push_back(v);
+			vBint.push_back(v);
+		}
+		else {
+			rBint.push_front(v);
+			vBint.push_front(v);
+		}
+		if (i % 5 == 0) {
+			rBint.pop_back();
+			vBint.pop_back();
+		}
+	}
+	if (!isEqual(vBint, rBint) || !(rBint.front() == vBint.front()) || !(rBint.back() == vBint.back()))
+		error();
+	while (!rBint.empty())
+		rBint.pop_front();
+	try {
+		rBint.pop_back();
+		error();
+	} catch (...) {}
+	std::cout << "Correct." << std::endl;
+}
+
+void TestInsertAndErase()
+{
+	std::cout << "Test 3 : Test for random insert and erase of single elements...";
+	sjtu::rope<long long> rInt;
+	std::vector<long long> vInt;
+	for (long long i = 0; i < 20000; ++i) {
+		int op = myRandom() % 5;
+		if (op <= 2 || vInt.empty()) {
+			size_t k = myRandom() % (vInt.size() + 1);
+			vInt.insert(vInt.begin() + k, i);
+			if (*rInt.insert(rInt.begin() + k, i) != i)
+				error();
+		}
+		else {
+			size_t k = myRandom() % vInt.size();
+			vInt.erase(vInt.begin() + k);
+			auto it = rInt.erase(rInt.begin() + k);
+			if (k < vInt.size() && *it != vInt[k])
+				error();
+		}
+	}
+	if (!isEqual(vInt, rInt))
+		error();
+
+	//the value inserted may be an element of the rope itself, which is moved by the insertion
+	sjtu::rope<std::string> rStr;
+	std::vector<std::string> vStr;
+	for (int i = 0; i < 10; ++i) {
+		rStr.push_back(std::to_string(i));
+		vStr.push_back(std::to_string(i));
+	}
+	rStr.insert(rStr.begin() + 7, rStr[2]);
+	vStr.insert(vStr.begin() + 7, std::string("2"));
+	for (int i = 0; i < 20000; ++i) {
+		size_t from = myRandom() % vStr.size(), k = myRandom() % (vStr.size() + 1);
+		std::string value = vStr[from];
+		if (i % 3 == 0) {
+			rStr.push_back(rStr[from]);
+			vStr.push_back(value);
+		}
+		else if (i % 3 == 1) {
+			rStr.push_front(rStr[from]);
+			vStr.insert(vStr.begin(), value);
+		}
+		else {
+			rStr.insert(rStr.begin() + k, rStr[from]);
+			vStr.insert(vStr.begin() + k, value);
+		}
+	}
+	if (!isEqual(vStr, rStr))
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestRange()
+{
+	std::cout << "Test 4 : Test for insert and erase of ranges...";
+	sjtu::rope<std::string> rStr;
+	std::vector<std::string> vStr;
+	for (int i = 0; i < 2000; ++i) {
+		int op = myRandom() % 3;
+		if (op <= 1 || vStr.empty()) {
+			std::vector<std::string> range;
+			int len = myRandom() % 300;
+			for (int j = 0; j < len; ++j)
+				range.push_back(std::to_string(i) + "-" + std::to_string(j));
+			size_t k = myRandom() % (vStr.size() + 1);
+			vStr.insert(vStr.begin() + k, range.begin(), range.end());
+			auto it = rStr.insert(rStr.begin() + k, range.begin(), range.end());
+			if (it - rStr.begin() != (int)k)
+				error();
+		}
+		else {
+			size_t a = myRandom() % (vStr.size() + 1), b = myRandom() % (vStr.size() + 1);
+			if (a > b)
+				std::swap(a, b);
+			vStr.erase(vStr.begin() + a, vStr.begin() + b);
+			auto it = rStr.erase(rStr.begin() + a, rStr.begin() + b);
+			if (a < vStr.size() && *it != vStr[a])
+				error();
+		}
+	}
+	if (!isEqual(vStr, rStr))
+		error();
+	try {
+		rStr.erase(rStr.begin() + 1, rStr.begin());
+		error();
+	} catch (...) {}
+	std::cout << "Correct." << std::endl;
+}
+
+void TestSplitAndConcat()
+{
+	std::cout << "Test 5 : Test for split and concat...";
+	std::vector<int> v;
+	for (int i = 0; i < N; ++i)
+		v.push_back(i);
+	sjtu::rope<int> r(v.begin(), v.end());
+	for (int i = 0; i < 1000; ++i) {
+		//cut a random piece out and append it at the end
+		size_t a = myRandom() % (v.size() + 1), b = myRandom() % (v.size() + 1);
+		if (a > b)
+			std::swap(a, b);
+		sjtu::rope<int> right = r.split(b);
+		sjtu::rope<int> mid = r.split(a);
+		if (r.size() != a || mid.size() != b - a)
+			error();
+		r.concat(right);
+		r.concat(mid);
+		if (!right.empty() || !mid.empty())
+			error();
+
+		std::vector<int> piece(v.begin() + a, v.begin() + b);
+		v.erase(v.begin() + a, v.begin() + b);
+		v.insert(v.end(), piece.begin(), piece.end());
+	}
+	if (!isEqual(v, r))
+		error();
+	r.concat(r);
+	v.insert(v.end(), v.begin(), v.end());
+	if (!isEqual(v, r))
+		error();
+	try {
+		r.split(r.size() + 1);
+		error();
+	} catch (...) {}
+	std::cout << "Correct." << std::endl;
+}
+
+void TestIterator()
+{
+	std::cout << "Test 6 : Test for iterator arithmetic...";
+	sjtu::rope<int> rInt;
+	for (int i = 0; i < N; ++i)
+		rInt.push_front(i);
+	std::uniform_int_distribution<int> pos(0, N - 1);
+	for (int i = 0; i < N; ++i) {
+		int a = pos(myRandom), b = pos(myRandom);
+		auto ia = rInt.begin() + a;
+		auto ib = rInt.end() - (N - b);
+		if (ia - ib != a - b || *ia != N - 1 - a || *ib != N - 1 - b)
+			error();
+		ia += b - a;
+		if (ia != ib)
+			error();
+	}
+	int cnt = 0;
+	for (auto it = rInt.end(); it != rInt.begin();) {
+		--it;
+		if (*it != cnt++)
+			error();
+	}
+	try {
+		rInt.end() + 1;
+		error();
+	} catch (...) {}
+	try {
+		rInt.begin() - 1;
+		error();
+	} catch (...) {}
+	try {
+		*rInt.end();
+		error();
+	} catch (...) {}
+	std::cout << "Correct." << std::endl;
+}
+
+void TestCopyConstructorAndOperatorEqu()
+{
+	std::cout << "Test 7 : Test for copy constructor and operator=...";
+	sjtu::rope<std::string> *pStr = new sjtu::rope<std::string>;
+	std::vector<std::string> vStr;
+	for (int i = 0; i < N / 5; ++i) {
+		size_t k = myRandom() % (vStr.size() + 1);
+		pStr->insert(pStr->begin() + k, std::to_string(i));
+		vStr.insert(vStr.begin() + k, std::to_string(i));
+	}
+	sjtu::rope<std::string> dual(*pStr), dualOper;
+	dualOper = *pStr;
+	dualOper = dualOper;
+	delete pStr;
+	if (!isEqual(vStr, dual) || !isEqual(vStr, dualOper))
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestSpeed()
+{
+	std::cout << "Test 8 : Test for speed of 1,000,000 middle operations on 10,000,000 elements...";
+	clock_t start = clock();
+	sjtu::rope<int> r;
+	std::vector<int> chunk(1000);
+	for (int i = 0; i < 10000; ++i)
+		r.insert(r.end(), chunk.begin(), chunk.end());
+	long long sum = 0;
+	for (int i = 0; i < 1000000; ++i) {
+		size_t k = myRandom() % r.size();
+		switch (i % 4) {
+		case 0:
+			r.insert(r.begin() + k, i);
+			break;
+		case 1:
+			r.erase(r.begin() + k);
+			break;
+		case 2:
+			sum += r[k];
+			break;
+		default:
+			{
+				sjtu::rope<int> tail = r.split(k);
+				r.concat(tail);
+			}
+		}
+	}
+	if (r.size() != 10000000)
+		error();
+	std::cout << "Correct. (" << (double)(clock() - start) / CLOCKS_PER_SEC << "s)" << std::endl;
+	if (sum == -1)
+		std::cout << sum << std::endl;
+}
+
+int main()
+{
+	TestInteger();
+	TestPushAndPop();
+	TestInsertAndErase();
+	TestRange();
+	TestSplitAndConcat();
+	TestIterator();
+	TestCopyConstructorAndOperatorEqu();
+	TestSpeed();
+	std::cout << "Congratulations. Your rope has passed all correctness tests." << std::endl;
+	return 0;
+}
@@ -0,0 +1,214 @@
+//Correctness and speed test for sjtu::work_stealing_deque and sjtu::thread_pool.
+#include <iostream>
+#include <vector>
+#include <algorithm>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+
+#include "../../include/thread_pool.hpp"
+
+std::default_random_engine myRandom(20181001);
+
+void error()
+{
+	std::cout << "Error, mismatch found." << std::endl;
+	exit(0);
+}
+
+double elapsed(std::chrono::steady_clock::time_point start)
+{
+	return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+void TestDeque()
+{
+	std::cout << "Test 1 : Test for push, pop and steal of work_stealing_deque...";
+	const int N = 300000, thieves = 3;
+	sjtu::work_stealing_deque<int> d(4);//small, so that it grows while thieves are reading
+	std::vector<std::atomic<int> > seen(N);
+	for (auto &x : seen)
+		x.store(0);
+	std::atomic<bool> finished(false);
+
+	std::vector<std::thread> threads;
+	for (int t = 0; t < thieves; ++t)
+		threads.push_back(std::thread([&]() {
+			int v;
+			while (!finished.load() || !d.empty()) {
+				if (d.steal(v))
+					seen[v]++;
+				else
+					std::this_thread::yield();
+			}
+		}));
+
+	//the owner pushes in bursts and pops some of them back, newest first
+	int v, last = N;
+	for (int i = 0; i < N;) {
+		int burst = myRandom() % 64 + 1;
+		for (int j = 0; j < burst && i < N; ++j)
+			d.push(i++);
+		for (int j = myRandom() % 32; j > 0 && d.pop(v); --j) {
+			if (v >= last)
+				error();
+			last = v;
+			seen[v]++;
+		}
+		last = N;
+	}
+	while (d.pop(v))
+		seen[v]++;
+	finished = true;
+	for (auto &th : threads)
+		th.join();
+
+	for (auto &x : seen)
+		if (x.load() != 1)
+			error();
+	std::cout << "Correct." << std::endl;
+}
+
+long long fib(sjtu::thread_pool &pool, int n)
+{
+	if (n < 20) {
+		long long a = 0, b = 1;
+		for (int i = 0; i < n; ++i) {
+			long long c = a + b;
+			a = b;
+			b = c;
+		}
+		return a;
+	}
+	long long x, y;
+	pool.parallel_invoke([&]() { x = fib(pool, n - 1); }, [&]() { y = fib(pool, n - 2); });
+	return x + y;
+}
+
+void TestInvoke()
+{
+	std::cout << "Test 2 : Test for nested parallel_invoke...";
+	sjtu::thread_pool pool(4);
+	if (pool.size() != 4 || fib(pool, 32) != 2178309)
+		error();
+	int a = 0, b = 0, c = 0, d = 0;
+	pool.parallel_invoke([&]() { a = 1; }, [&]() { b = 2; }, [&]() { c = 3; }, [&]() { d = 4; });
+	if (a != 1 || b != 2 || c != 3 || d != 4)
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestFor()
+{
+	std::cout << "Test 3 : Test for parallel_for...";
+	sjtu::thread_pool pool(4);
+	const int N = 1000000;
+	std::vector<int> a(N, 0);
+	pool.parallel_for(0, N, [&](int i) { a[i] += i % 7; });
+	for (int i = 0; i < N; ++i)
+		if (a[i] != i % 7)
+			error();
+
+	//nested loops with a given grain, and empty ranges
+	std::vector<std::atomic<int> > cnt(100);
+	for (auto &x : cnt)
+		x.store(0);
+	pool.parallel_for(0, 100, [&](int i) {
+		pool.parallel_for(0, i, [&](int j) { cnt[j]++; }, 3);
+	}, 1);
+	for (int j = 0; j < 100; ++j)
+		if (cnt[j].load() != 99 - j)
+			error();
+	pool.parallel_for(5, 5, [&](int) { error(); });
+	pool.parallel_for((size_t)0, (size_t)10, [&](size_t i) { a[i] = -1; });
+	if (a[9] != -1 || a[10] != 10 % 7)
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+void TestException()
+{
+	std::cout << "Test 4 : Test for exceptions thrown by the tasks...";
+	sjtu::thread_pool pool(3);
+	std::atomic<int> done(0);
+	try {
+		pool.parallel_for(0, 1000, [&](int i) {
+			if (i == 777)
+				throw std::runtime_error("777");
+			done++;
+		}, 10);
+		error();
+	} catch (std::runtime_error &e) {
+		if (std::string(e.what()) != "777")
+			error();
+	}
+	try {
+		pool.parallel_invoke([]() {}, []() { throw 1; });
+		error();
+	} catch (int) {}
+	//the pool is still usable
+	if (fib(pool, 25) != 75025)
+		error();
+	std::cout << "Correct." << std::endl;
+}
+
+//sort the halves in parallel and merge them back
+template<class Iter>
+void parallelSort(sjtu::thread_pool &pool, Iter first, Iter last, Iter buf)
+{
+	if (last - first < 20000) {
+		std::sort(first, last);
+		return;
+	}
+	Iter mid = first + (last - first) / 2;
+	pool.parallel_invoke([&]() { parallelSort(pool, first, mid, buf); },
+		[&]() { parallelSort(pool, mid, last, buf + (mid - first)); });
+	std::merge(first, mid, mid, last, buf);
+	std::copy(buf, buf + (last - first), first);
+}
+
+void TestSpeed()
+{
+	std::cout << "Test 5 : Test for speed of sorting and summing 10,000,000 integers..." << std::endl;
+	const int N = 10000000;
+	std::vector<int> a(N), b, buf(N);
+	for (int i = 0; i < N; ++i)
+		a[i] = myRandom();
+	b = a;
+
+	auto start = std::chrono::steady_clock::now();
+	std::sort(a.begin(), a.end());
+	long long sum = 0;
+	for (int i = 0; i < N; ++i)
+		sum += a[i] % 1000;
+	std::cout << "    sequential : " << elapsed(start) << "s" << std::endl;
+
+	sjtu::thread_pool pool;
+	start = std::chrono::steady_clock::now();
+	parallelSort(pool, b.begin(), b.end(), buf.begin());
+	std::vector<long long> partial(64, 0);
+	pool.parallel_for(0, 64, [&](int k) {
+		for (int i = N / 64 * k; i < (k == 63 ? N : N / 64 * (k + 1)); ++i)
+			partial[k] += b[i] % 1000;
+	}, 1);
+	long long psum = 0;
+	for (int k = 0; k < 64; ++k)
+		psum += partial[k];
+	std::cout << "    thread_pool with " << pool.size() << " workers : " << elapsed(start) << "s" << std::endl;
+
+	if (a != b || sum != psum)
+		error();
+}
+
+int main()
+{
+	TestDeque();
+	TestInvoke();
+	TestFor();
+	TestException();
+	TestSpeed();
+	std::cout << "Congratulations. Your thread pool has passed all correctness tests." << std::endl;
+	return 0;
+}